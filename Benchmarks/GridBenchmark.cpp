@@ -0,0 +1,411 @@
+#include <JuceHeader.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "Grid.h"
+#include "MixKernel.h"
+
+/**
+ * Micro-benchmark comparing the bit-packed Grid::update() against the original
+ * bool-array implementation (reproduced below as LegacyGrid).
+ * Both grids are seeded with the same pattern and checked for identical results.
+ * Every preset rule is also checked against a plain per-cell stepper (ReferenceGrid) on grids
+ * one, two and four words wide, seeded sparsely at times so unchanged tiles are skipped.
+ *
+ * Also compares MixKernel::mix() against the original per-sample voice loop (legacyMixVoice),
+ * reported as the voices one core can mix in real time.
+ */
+namespace
+{
+    constexpr int SIZE = ParameterManager::GRID_SIZE;
+
+    // The original bool[16][16] implementation of Grid::update()
+    struct LegacyGrid
+    {
+        bool grid[SIZE][SIZE] = {};
+        bool nextGrid[SIZE][SIZE] = {};
+        bool previousGrid[SIZE][SIZE] = {};
+
+        int countLiveNeighbors(int x, int y) const
+        {
+            int count = 0;
+            for (int dy = -1; dy <= 1; ++dy)
+            {
+                for (int dx = -1; dx <= 1; ++dx)
+                {
+                    if (dx == 0 && dy == 0)
+                        continue;
+
+                    int nx = (x + dx + SIZE) % SIZE;
+                    int ny = (y + dy + SIZE) % SIZE;
+
+                    if (grid[ny][nx])
+                        count++;
+                }
+            }
+            return count;
+        }
+
+        void update()
+        {
+            for (int y = 0; y < SIZE; ++y)
+                for (int x = 0; x < SIZE; ++x)
+                    previousGrid[y][x] = grid[y][x];
+
+            for (int y = 0; y < SIZE; ++y)
+            {
+                for (int x = 0; x < SIZE; ++x)
+                {
+                    int liveNeighbors = countLiveNeighbors(x, y);
+                    nextGrid[y][x] = grid[y][x] ? (liveNeighbors == 2 || liveNeighbors == 3)
+                                                : (liveNeighbors == 3);
+                }
+            }
+
+            for (int y = 0; y < SIZE; ++y)
+                for (int x = 0; x < SIZE; ++x)
+                    grid[y][x] = nextGrid[y][x];
+        }
+    };
+
+    // Seed both grids with the same random pattern
+    void seed(LegacyGrid& legacy, GameOfLifeApp::Grid& grid, juce::Random& random)
+    {
+        for (int y = 0; y < SIZE; ++y)
+        {
+            for (int x = 0; x < SIZE; ++x)
+            {
+                bool alive = random.nextInt(100) < 35;
+                legacy.grid[y][x] = alive;
+                grid.setCellState(x, y, alive);
+            }
+        }
+    }
+
+    bool gridsMatch(const LegacyGrid& legacy, const GameOfLifeApp::Grid& grid)
+    {
+        for (int y = 0; y < SIZE; ++y)
+            for (int x = 0; x < SIZE; ++x)
+                if (legacy.grid[y][x] != grid.getCellState(x, y))
+                    return false;
+        return true;
+    }
+
+    // Per-cell stepper for any rule and grid size, including the dying cells of a Generations rule
+    struct ReferenceGrid
+    {
+        int width = 0;
+        int height = 0;
+        GameOfLifeApp::LifeRule rule;
+        std::vector<uint8_t> alive;
+        std::vector<uint8_t> dying;     // generations a dying cell has left (0 if not dying)
+
+        ReferenceGrid(int w, int h, const GameOfLifeApp::LifeRule& r)
+            : width(w), height(h), rule(r),
+              alive(static_cast<size_t>(w * h)), dying(static_cast<size_t>(w * h))
+        {
+        }
+
+        int index(int x, int y) const { return ((y + height) % height) * width + (x + width) % width; }
+
+        void update()
+        {
+            std::vector<uint8_t> nextAlive(alive.size());
+            std::vector<uint8_t> nextDying(dying.size());
+
+            for (int y = 0; y < height; ++y)
+            {
+                for (int x = 0; x < width; ++x)
+                {
+                    // Only live cells count as neighbours
+                    int neighbours = 0;
+                    for (int dy = -1; dy <= 1; ++dy)
+                        for (int dx = -1; dx <= 1; ++dx)
+                            if ((dx != 0 || dy != 0) && alive[static_cast<size_t>(index(x + dx, y + dy))])
+                                ++neighbours;
+
+                    const size_t i = static_cast<size_t>(index(x, y));
+
+                    if (alive[i])
+                    {
+                        nextAlive[i] = (rule.survive >> neighbours) & 1;
+
+                        if (! nextAlive[i] && rule.isGenerations())
+                            nextDying[i] = static_cast<uint8_t>(rule.getDyingGenerations());
+                    }
+                    else if (dying[i] > 0)
+                    {
+                        // A dying cell cannot be born; it counts down to dead
+                        nextDying[i] = static_cast<uint8_t>(dying[i] - 1);
+                    }
+                    else
+                    {
+                        nextAlive[i] = (rule.birth >> neighbours) & 1;
+                    }
+                }
+            }
+
+            alive.swap(nextAlive);
+            dying.swap(nextDying);
+        }
+    };
+
+    // Seed both grids with the same random pattern: the whole grid, or a single patch of it
+    void seed(ReferenceGrid& reference, GameOfLifeApp::Grid& grid, juce::Random& random, bool patch)
+    {
+        grid.initialize(false);
+
+        const int patchWidth = patch ? juce::jmax(4, reference.width / 4) : reference.width;
+        const int patchHeight = patch ? juce::jmax(4, reference.height / 4) : reference.height;
+        const int left = random.nextInt(reference.width - patchWidth + 1);
+        const int top = random.nextInt(reference.height - patchHeight + 1);
+
+        for (int y = 0; y < reference.height; ++y)
+        {
+            for (int x = 0; x < reference.width; ++x)
+            {
+                const bool inPatch = x >= left && x < left + patchWidth && y >= top && y < top + patchHeight;
+                const bool alive = inPatch && random.nextInt(100) < 35;
+
+                reference.alive[static_cast<size_t>(y * reference.width + x)] = alive;
+                reference.dying[static_cast<size_t>(y * reference.width + x)] = 0;
+                grid.setCellState(x, y, alive);
+            }
+        }
+    }
+
+    bool gridsMatch(const ReferenceGrid& reference, const GameOfLifeApp::Grid& grid)
+    {
+        for (int y = 0; y < reference.height; ++y)
+        {
+            for (int x = 0; x < reference.width; ++x)
+            {
+                const size_t i = static_cast<size_t>(y * reference.width + x);
+
+                if (grid.getCellState(x, y) != (reference.alive[i] != 0) || grid.getDyingState(x, y) != reference.dying[i])
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    // Step a grid of the given size and rule alongside the reference stepper
+    bool matchesReference(GameOfLifeApp::Grid& grid, const GameOfLifeApp::LifeRule& rule, int width, int height,
+                          int generations, juce::Random& random)
+    {
+        grid.setSize(width, height);
+        grid.setRule(rule);
+        ReferenceGrid reference(width, height, rule);
+
+        for (int i = 0; i < generations; ++i)
+        {
+            // Reseed periodically, alternating between the whole grid and a patch
+            if (i % 50 == 0)
+                seed(reference, grid, random, (i / 50) % 2 == 1);
+
+            reference.update();
+            grid.update();
+
+            if (! gridsMatch(reference, grid))
+            {
+                std::printf("Mismatch between reference and bit-packed grid (%s, %dx%d) at generation %d\n",
+                            rule.toString().toRawUTF8(), width, height, i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // The original Voice::processBlock() inner loop: truncated positions and checked accessors
+    void legacyMixVoice(const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                        int playbackPosition, float playbackRate, float leftGain, float rightGain)
+    {
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            float channelGain = (channel == 0) ? leftGain : rightGain;
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                float exactSamplePos = playbackPosition + (i * playbackRate);
+                int samplePos = static_cast<int>(exactSamplePos);
+
+                if (samplePos < sample.getNumSamples())
+                {
+                    float value = channel < sample.getNumChannels() ? sample.getSample(channel, samplePos)
+                                                                    : sample.getSample(0, samplePos);
+                    buffer.addSample(channel, i, value * channelGain);
+                }
+            }
+        }
+    }
+
+    // Amplitude of a sine wave after sinc resampling at rate; frequency is a fraction of the
+    // output's Nyquist frequency
+    float sincGain(float frequency, float rate)
+    {
+        constexpr int sourceLength = 16384;
+        constexpr int outputLength = 4096;
+
+        juce::AudioBuffer<float> sine(1, sourceLength);
+        for (int i = 0; i < sourceLength; ++i)
+            sine.setSample(0, i, std::sin(juce::MathConstants<float>::pi * frequency / rate * static_cast<float>(i)));
+
+        juce::AudioBuffer<float> resampled(1, outputLength);
+        resampled.clear();
+
+        const MixKernel::Source source { sine.getReadPointer(0), sine.getReadPointer(0), sourceLength };
+        const MixKernel::Output output { resampled.getWritePointer(0), nullptr, outputLength };
+        MixKernel::mix(source, 1024.0, rate, 1.0f, 1.0f, output, MixKernel::Interpolation::Sinc);
+
+        return resampled.getRMSLevel(0, 0, outputLength) * juce::MathConstants<float>::sqrt2;
+    }
+
+    template <typename UpdateFunc>
+    double nanosecondsPerGeneration(int generations, UpdateFunc&& update)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i)
+            update();
+        auto end = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double, std::nano>(end - start).count() / generations;
+    }
+}
+
+int main()
+{
+    constexpr int verifyGenerations = 1000;
+    constexpr int benchmarkGenerations = 200000;
+
+    juce::Random random(12345);
+    LegacyGrid legacy;
+    GameOfLifeApp::Grid grid;
+
+    // Verify that both implementations produce identical generations
+    seed(legacy, grid, random);
+    for (int i = 0; i < verifyGenerations; ++i)
+    {
+        // Reseed periodically so the pattern doesn't settle into a still life
+        if (i % 50 == 0)
+            seed(legacy, grid, random);
+
+        legacy.update();
+        grid.update();
+
+        if (!gridsMatch(legacy, grid))
+        {
+            std::printf("Mismatch between legacy and bit-packed grid at generation %d\n", i);
+            return 1;
+        }
+    }
+
+    // Verify every preset rule on grids one, two and four words wide
+    auto checkedGrid = std::make_unique<GameOfLifeApp::Grid>();
+    constexpr int checkedSizes[][2] = { { SIZE, SIZE }, { 100, 40 }, { 200, 24 } };
+
+    for (const auto& preset : GameOfLifeApp::LIFE_RULE_PRESETS)
+    {
+        GameOfLifeApp::LifeRule rule;
+        GameOfLifeApp::LifeRule::parse(preset.ruleString, rule);
+
+        for (const auto& size : checkedSizes)
+            if (! matchesReference(*checkedGrid, rule, size[0], size[1], 200, random))
+                return 1;
+    }
+
+    seed(legacy, grid, random);
+    double legacyTime = nanosecondsPerGeneration(benchmarkGenerations, [&] { legacy.update(); });
+
+    seed(legacy, grid, random);
+    double bitboardTime = nanosecondsPerGeneration(benchmarkGenerations, [&] { grid.update(); });
+
+    std::printf("Grid %dx%d, %d generations\n", SIZE, SIZE, benchmarkGenerations);
+    std::printf("  legacy bool[][] update : %8.1f ns/generation\n", legacyTime);
+    std::printf("  bitboard update        : %8.1f ns/generation\n", bitboardTime);
+    std::printf("  speedup                : %8.1fx\n", legacyTime / bitboardTime);
+
+    // Compiled rules should cost about the same as the Conway fast path
+    std::printf("Rules (bitboard update):\n");
+    for (const auto& preset : GameOfLifeApp::LIFE_RULE_PRESETS)
+    {
+        GameOfLifeApp::LifeRule rule;
+        GameOfLifeApp::LifeRule::parse(preset.ruleString, rule);
+        grid.setRule(rule);
+
+        seed(legacy, grid, random);
+        double ruleTime = nanosecondsPerGeneration(benchmarkGenerations, [&] { grid.update(); });
+        std::printf("  %-22s : %8.1f ns/generation\n", preset.ruleString, ruleTime);
+    }
+
+    // Voice mixing: a one-second stereo sample pitched up three semitones, in 512-sample blocks
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int mixBlocks = 100000;
+    const float rate = std::pow(2.0f, 3.0f / 12.0f);
+
+    juce::AudioBuffer<float> sample(2, static_cast<int>(sampleRate));
+    for (int channel = 0; channel < sample.getNumChannels(); ++channel)
+        for (int i = 0; i < sample.getNumSamples(); ++i)
+            sample.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+    juce::AudioBuffer<float> output(2, blockSize);
+    output.clear();
+
+    const int lastStart = sample.getNumSamples() - static_cast<int>(blockSize * rate) - 2;
+    const MixKernel::Source source { sample.getReadPointer(0), sample.getReadPointer(1), sample.getNumSamples() };
+    const MixKernel::Output mixOutput { output.getWritePointer(0), output.getWritePointer(1), blockSize };
+
+    int block = 0;
+    double legacyMixTime = nanosecondsPerGeneration(mixBlocks, [&] {
+        legacyMixVoice(sample, output, (block++ * 97) % lastStart, rate, 0.5f, 0.5f);
+    });
+
+    block = 0;
+    double scalarMixTime = nanosecondsPerGeneration(mixBlocks, [&] {
+        MixKernel::mixScalar(source, (block++ * 97) % lastStart, rate, 0.5f, 0.5f, mixOutput);
+    });
+
+    block = 0;
+    double kernelMixTime = nanosecondsPerGeneration(mixBlocks, [&] {
+        MixKernel::mix(source, (block++ * 97) % lastStart, rate, 0.5f, 0.5f, mixOutput);
+    });
+
+    MixKernel::prepareTables();
+
+    block = 0;
+    double cubicMixTime = nanosecondsPerGeneration(mixBlocks, [&] {
+        MixKernel::mix(source, (block++ * 97) % lastStart, rate, 0.5f, 0.5f, mixOutput, MixKernel::Interpolation::Cubic);
+    });
+
+    block = 0;
+    double sincMixTime = nanosecondsPerGeneration(mixBlocks / 10, [&] {
+        MixKernel::mix(source, (block++ * 97) % lastStart, rate, 0.5f, 0.5f, mixOutput, MixKernel::Interpolation::Sinc);
+    });
+
+    // A small pitch up must keep the sinc passband (within 0.5 dB up to 0.7 of Nyquist), not
+    // fall back to the cutoff of a whole octave up
+    for (const float checkRate : { 1.0f, std::pow(2.0f, 1.0f / 12.0f), 1.5f })
+    {
+        const float gain = sincGain(0.7f, checkRate);
+
+        if (gain < 0.944f)
+        {
+            std::printf("Sinc resampling at rate %.3f loses its passband (gain %.3f at 0.7 of Nyquist)\n", checkRate, gain);
+            return 1;
+        }
+    }
+
+    // Voices one core could mix within the duration of a block
+    const double blockNanoseconds = blockSize / sampleRate * 1.0e9;
+
+    std::printf("Voice mixing, stereo, %d-sample blocks at %.0f Hz (%s kernel)\n", blockSize, sampleRate, MixKernel::getImplementationName());
+    std::printf("  legacy per-sample loop : %8.1f ns/block, %8.0f voices/core\n", legacyMixTime, blockNanoseconds / legacyMixTime);
+    std::printf("  scalar interpolating   : %8.1f ns/block, %8.0f voices/core\n", scalarMixTime, blockNanoseconds / scalarMixTime);
+    std::printf("  vector interpolating   : %8.1f ns/block, %8.0f voices/core\n", kernelMixTime, blockNanoseconds / kernelMixTime);
+    std::printf("  vector cubic           : %8.1f ns/block, %8.0f voices/core\n", cubicMixTime, blockNanoseconds / cubicMixTime);
+    std::printf("  windowed sinc          : %8.1f ns/block, %8.0f voices/core\n", sincMixTime, blockNanoseconds / sincMixTime);
+    return 0;
+}
@@ -0,0 +1,377 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+ #include <intrin.h>
+#endif
+
+namespace GameOfLifeApp {
+
+/**
+ * Small helpers for working with 64-bit cell words
+ */
+namespace BitOps
+{
+    // Number of set bits in a word
+    inline int popCount(uint64_t word)
+    {
+       #if defined(_MSC_VER) && defined(_M_X64)
+        return static_cast<int>(__popcnt64(word));
+       #elif defined(_MSC_VER)
+        return static_cast<int>(__popcnt(static_cast<uint32_t>(word)) + __popcnt(static_cast<uint32_t>(word >> 32)));
+       #else
+        return __builtin_popcountll(word);
+       #endif
+    }
+
+    // Index of the lowest set bit (word must be non-zero)
+    inline int lowestSetBit(uint64_t word)
+    {
+       #if defined(_MSC_VER) && defined(_M_X64)
+        unsigned long index;
+        _BitScanForward64(&index, word);
+        return static_cast<int>(index);
+       #elif defined(_MSC_VER)
+        unsigned long index;
+        if (_BitScanForward(&index, static_cast<uint32_t>(word)))
+            return static_cast<int>(index);
+        _BitScanForward(&index, static_cast<uint32_t>(word >> 32));
+        return static_cast<int>(index) + 32;
+       #else
+        return __builtin_ctzll(word);
+       #endif
+    }
+}
+
+/**
+ * Grid dimensions, either fixed at compile time or (for BitBoard<0, 0>) chosen at runtime
+ */
+template <int Width, int Height>
+struct BoardDimensions
+{
+    static constexpr bool IS_DYNAMIC = false;
+    static constexpr int MAX_WIDTH = Width;
+    static constexpr int MAX_HEIGHT = Height;
+
+    constexpr int width() const { return Width; }
+    constexpr int height() const { return Height; }
+};
+
+template <>
+struct BoardDimensions<0, 0>
+{
+    // Largest grid supported by a runtime-sized board
+    static constexpr bool IS_DYNAMIC = true;
+    static constexpr int MAX_WIDTH = 256;
+    static constexpr int MAX_HEIGHT = 256;
+
+    int width() const { return dynamicWidth; }
+    int height() const { return dynamicHeight; }
+
+    int dynamicWidth = 16;
+    int dynamicHeight = 16;
+};
+
+/**
+ * Bit-packed storage for a toroidal cell grid.
+ * Each row is packed into 64-bit words, bit (x % 64) of word (x / 64) holds column x.
+ * Bits beyond the grid width are always kept at zero.
+ *
+ * BitBoard<W, H> has its size fixed at compile time so the common grid sizes get
+ * fully specialised code; BitBoard<0, 0> is sized at runtime up to MAX_WIDTH x MAX_HEIGHT.
+ */
+template <int Width, int Height>
+class BitBoard : private BoardDimensions<Width, Height>
+{
+    using Dimensions = BoardDimensions<Width, Height>;
+
+public:
+    using Word = uint64_t;
+
+    static constexpr bool IS_DYNAMIC = Dimensions::IS_DYNAMIC;
+    static constexpr int MAX_WIDTH = Dimensions::MAX_WIDTH;
+    static constexpr int MAX_HEIGHT = Dimensions::MAX_HEIGHT;
+    static constexpr int WORD_BITS = 64;
+    static constexpr int MAX_WORDS_PER_ROW = (MAX_WIDTH + WORD_BITS - 1) / WORD_BITS;
+
+    using Row = std::array<Word, MAX_WORDS_PER_ROW>;
+
+    // Change tracking works on tiles of TILE_ROWS rows by one word; bit k of entry b in a
+    // TileMask covers word k of the rows in band b
+    static constexpr int TILE_ROWS = 8;
+    static constexpr int MAX_BANDS = (MAX_HEIGHT + TILE_ROWS - 1) / TILE_ROWS;
+
+    using TileMask = std::array<Word, MAX_BANDS>;
+
+    using Dimensions::width;
+    using Dimensions::height;
+
+    // Number of words in use per row
+    int wordsPerRow() const { return (width() + WORD_BITS - 1) / WORD_BITS; }
+
+    // Change the size of a runtime-sized board (clears the board)
+    void resize(int newWidth, int newHeight)
+    {
+        static_assert(IS_DYNAMIC, "Only runtime-sized boards can be resized");
+        jassert(newWidth > 0 && newWidth <= MAX_WIDTH && newHeight > 0 && newHeight <= MAX_HEIGHT);
+
+        this->dynamicWidth = newWidth;
+        this->dynamicHeight = newHeight;
+        clear();
+    }
+
+    // Number of tile bands in use
+    int numBands() const { return (height() + TILE_ROWS - 1) / TILE_ROWS; }
+
+    // Mask with one bit set for each word in use
+    Word allWordsMask() const
+    {
+        return wordsPerRow() == WORD_BITS ? ~Word(0) : ((Word(1) << wordsPerRow()) - 1);
+    }
+
+    // Tiles that need updating when the given tiles changed: each changed tile and its
+    // eight neighbours, wrapping around the grid edges
+    void expandTileMask(const TileMask& changed, TileMask& expanded) const
+    {
+        const int bands = numBands();
+        const int words = wordsPerRow();
+        const Word all = allWordsMask();
+
+        for (int b = 0; b < bands; ++b)
+        {
+            const Word vertical = changed[(b + bands - 1) % bands] | changed[b] | changed[(b + 1) % bands];
+            const Word west = (vertical << 1) | (vertical >> (words - 1));
+            const Word east = (vertical >> 1) | (vertical << (words - 1));
+            expanded[b] = (vertical | west | east) & all;
+        }
+    }
+
+    // Mask of the valid bits in the last word of a row
+    Word lastWordMask() const
+    {
+        return (width() % WORD_BITS) == 0 ? ~Word(0) : ((Word(1) << (width() % WORD_BITS)) - 1);
+    }
+
+    // Clear all cells
+    void clear()
+    {
+        for (auto& row : rows)
+            row.fill(0);
+    }
+
+    // Get the state of a cell (coordinates must be in range)
+    bool get(int x, int y) const
+    {
+        return ((rows[y][x / WORD_BITS] >> (x % WORD_BITS)) & 1) != 0;
+    }
+
+    // Set the state of a cell (coordinates must be in range)
+    void set(int x, int y, bool state)
+    {
+        const Word bit = Word(1) << (x % WORD_BITS);
+
+        if (state)
+            rows[y][x / WORD_BITS] |= bit;
+        else
+            rows[y][x / WORD_BITS] &= ~bit;
+    }
+
+    // Direct row access
+    Row& row(int y) { return rows[y]; }
+    const Row& row(int y) const { return rows[y]; }
+
+    // Count the live cells on the board
+    int countLiveCells() const
+    {
+        int count = 0;
+        for (int y = 0; y < height(); ++y)
+            for (int k = 0; k < wordsPerRow(); ++k)
+                count += BitOps::popCount(rows[y][k]);
+        return count;
+    }
+
+    bool operator==(const BitBoard& other) const { return rows == other.rows; }
+    bool operator!=(const BitBoard& other) const { return rows != other.rows; }
+
+    // Row rotated so that each bit holds its western (x - 1) neighbour, wrapping at the grid edge
+    void shiftFromWest(const Row& in, Row& out) const
+    {
+        const int words = wordsPerRow();
+
+        for (int k = 0; k < words; ++k)
+            out[k] = (in[k] << 1) | (k > 0 ? in[k - 1] >> (WORD_BITS - 1) : 0);
+
+        out[0] |= (in[words - 1] >> ((width() - 1) % WORD_BITS)) & 1;
+        out[words - 1] &= lastWordMask();
+    }
+
+    // Row rotated so that each bit holds its eastern (x + 1) neighbour, wrapping at the grid edge
+    void shiftFromEast(const Row& in, Row& out) const
+    {
+        const int words = wordsPerRow();
+
+        for (int k = 0; k < words; ++k)
+            out[k] = (in[k] >> 1) | (k < words - 1 ? in[k + 1] << (WORD_BITS - 1) : 0);
+
+        out[words - 1] |= (in[0] & 1) << ((width() - 1) % WORD_BITS);
+    }
+
+private:
+    std::array<Row, MAX_HEIGHT> rows {};
+};
+
+/**
+ * Bit-sliced neighbour count for 64 cells at once.
+ * The count (0-8) of each cell is spread over four bit planes: count = s0 + 2*s1 + 4*s2 + 8*s3.
+ */
+struct NeighbourCount
+{
+    uint64_t s0, s1, s2, s3;
+};
+
+// Full-adder neighbour count from the eight neighbour words of a cell word
+inline NeighbourCount countNeighbours(uint64_t aboveWest, uint64_t above, uint64_t aboveEast,
+                                      uint64_t west, uint64_t east,
+                                      uint64_t belowWest, uint64_t below, uint64_t belowEast)
+{
+    // Horizontal sums of the row above and below (0-3) and of the current row (0-2)
+    const uint64_t a0 = aboveWest ^ above ^ aboveEast;
+    const uint64_t a1 = (aboveWest & above) | (aboveEast & (aboveWest ^ above));
+    const uint64_t b0 = belowWest ^ below ^ belowEast;
+    const uint64_t b1 = (belowWest & below) | (belowEast & (belowWest ^ below));
+    const uint64_t m0 = west ^ east;
+    const uint64_t m1 = west & east;
+
+    // Add the ones column, carrying into the twos column
+    NeighbourCount count;
+    count.s0 = a0 ^ b0 ^ m0;
+    const uint64_t c0 = (a0 & b0) | (m0 & (a0 ^ b0));
+
+    // Add the four twos-column inputs (a1, b1, m1, c0)
+    const uint64_t t = a1 ^ b1;
+    const uint64_t tc = a1 & b1;
+    const uint64_t u = m1 ^ c0;
+    const uint64_t uc = m1 & c0;
+    count.s1 = t ^ u;
+    const uint64_t c1 = t & u;
+
+    // Add the fours-column carries
+    count.s2 = tc ^ uc ^ c1;
+    count.s3 = (tc & uc) | (c1 & (tc ^ uc));
+    return count;
+}
+
+// Conway's B3/S23 applied to a bit-sliced neighbour count
+inline uint64_t applyConwayRule(const NeighbourCount& count, uint64_t alive)
+{
+    // Exactly 3 neighbours, or exactly 2 neighbours for a live cell
+    return count.s1 & ~count.s2 & ~count.s3 & (count.s0 | alive);
+}
+
+// Rule functor for the Conway fast path
+struct ConwayRule
+{
+    uint64_t operator()(const NeighbourCount& count, uint64_t alive) const { return applyConwayRule(count, alive); }
+};
+
+/**
+ * Compute the next generation of src into dst with word-parallel bit operations.
+ * Rows and columns wrap around (toroidal grid).
+ * The rule is a functor mapping (neighbour count, alive) words to the next-state word.
+ *
+ * If tilesToUpdate is given, only those tiles are computed: the others must already hold
+ * their next state in dst (true for a tile whose neighbourhood did not change, since dst
+ * holds the generation before src). If changedTiles is given, it receives the tiles
+ * whose cells changed.
+ */
+template <int Width, int Height, typename Rule = ConwayRule>
+void stepBitBoard(const BitBoard<Width, Height>& src, BitBoard<Width, Height>& dst, const Rule& rule = Rule(),
+                  const typename BitBoard<Width, Height>::TileMask* tilesToUpdate = nullptr,
+                  typename BitBoard<Width, Height>::TileMask* changedTiles = nullptr)
+{
+    using Board = BitBoard<Width, Height>;
+    using Word = typename Board::Word;
+    typename Board::Row aboveWest {}, aboveEast {}, west {}, east {}, belowWest {}, belowEast {};
+
+    const int height = src.height();
+    const int words = src.wordsPerRow();
+    const int bands = src.numBands();
+    const Word allWords = src.allWordsMask();
+
+    // The rolling window of shifted rows must be primed again after a skipped band
+    bool windowPrimed = false;
+
+    for (int b = 0; b < bands; ++b)
+    {
+        const Word update = (tilesToUpdate != nullptr) ? (*tilesToUpdate)[b] : allWords;
+        Word changed = 0;
+
+        if (update == 0)
+        {
+            windowPrimed = false;
+
+            if (changedTiles != nullptr)
+                (*changedTiles)[b] = 0;
+            continue;
+        }
+
+        const int yStart = b * Board::TILE_ROWS;
+        const int yEnd = juce::jmin(height, yStart + Board::TILE_ROWS);
+
+        if (!windowPrimed)
+        {
+            // Prime the rolling window with the row above the band and the band's first row
+            const int yAbove = (yStart == 0) ? height - 1 : yStart - 1;
+            src.shiftFromWest(src.row(yAbove), aboveWest);
+            src.shiftFromEast(src.row(yAbove), aboveEast);
+            src.shiftFromWest(src.row(yStart), west);
+            src.shiftFromEast(src.row(yStart), east);
+            windowPrimed = true;
+        }
+
+        for (int y = yStart; y < yEnd; ++y)
+        {
+            const int yAbove = (y == 0) ? height - 1 : y - 1;
+            const int yBelow = (y == height - 1) ? 0 : y + 1;
+
+            const auto& above = src.row(yAbove);
+            const auto& current = src.row(y);
+            const auto& below = src.row(yBelow);
+
+            src.shiftFromWest(below, belowWest);
+            src.shiftFromEast(below, belowEast);
+
+            auto& next = dst.row(y);
+            for (int k = 0; k < words; ++k)
+            {
+                if (((update >> k) & 1) == 0)
+                    continue;
+
+                const auto count = countNeighbours(aboveWest[k], above[k], aboveEast[k],
+                                                   west[k], east[k],
+                                                   belowWest[k], below[k], belowEast[k]);
+                next[k] = rule(count, current[k]);
+            }
+
+            // Rules with B0 would otherwise bring the padding bits beyond the grid width to life
+            next[words - 1] &= src.lastWordMask();
+
+            for (int k = 0; k < words; ++k)
+                changed |= static_cast<Word>(next[k] != current[k]) << k;
+
+            // Slide the window down one row
+            aboveWest = west;
+            aboveEast = east;
+            west = belowWest;
+            east = belowEast;
+        }
+
+        if (changedTiles != nullptr)
+            (*changedTiles)[b] = changed;
+    }
+}
+
+} // namespace GameOfLifeApp
@@ -1,5 +1,4 @@
 #include "DrumPad.h"
-#include "DebugLogger.h"
 
 DrumPad::DrumPad()
 {
@@ -18,9 +17,6 @@ DrumPad::DrumPad()
     // Initialize last played note and velocity
     lastPlayedNote = 0;
     lastPlayedVelocity = 0.0f;
-    
-    // Initialize refresh counter
-    refreshCounter = 0;
 }
 
 DrumPad::~DrumPad()
@@ -28,22 +24,23 @@ DrumPad::~DrumPad()
     // Nothing to clean up
 }
 
+void DrumPad::setVoicePool(VoicePool* pool, int padIndex)
+{
+    jassert(pool != nullptr && padIndex >= 0 && padIndex < VoicePool::NUM_PADS);
+    voicePool = pool;
+    poolPad = padIndex;
+}
+
 void DrumPad::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     // Store the sample rate for pitch shifting calculations
     currentSampleRate = sampleRate;
     
     // Reset playback state
-    activeVoices.clear();
+    voicePool->clearPad(poolPad);
     
     // Update envelope processor with the new sample rate
     envelopeProcessor.setSampleRate(sampleRate);
-    
-    // Set the sample rate for each voice
-    for (auto& voice : activeVoices)
-    {
-        voice.setSampleRate(sampleRate);
-    }
 }
 
 void DrumPad::loadSample(const juce::File& file)
@@ -69,164 +66,229 @@ void DrumPad::loadSample(const juce::File& file)
         filePath = file.getFullPathName();
         
         // Reset playback state
-        activeVoices.clear();
+        voicePool->clearPad(poolPad);
     }
 }
 
-void DrumPad::triggerSampleUnified(float velocity, int pitchShiftSemitones, int cellX, int cellY, float delayMs)
+float DrumPad::getPitchRatio(int pitchShiftSemitones)
 {
-    // Note: The delayMs parameter is handled at the processor level through the scheduleSampleWithDelay method.
-    // This function is designed to be called directly for immediate playback or indirectly through the scheduler.
+    // Playback rates for every shift in the table's range, computed once
+    static const auto ratios = []
+    {
+        std::array<float, 2 * PITCH_RATIO_RANGE + 1> table {};
+        for (int i = 0; i < static_cast<int>(table.size()); ++i)
+            table[static_cast<size_t>(i)] = std::pow(2.0f, (i - PITCH_RATIO_RANGE) / 12.0f);
+        return table;
+    }();
     
-    if (sampleBuffer.getNumSamples() == 0 || muted)
-        return;
+    if (pitchShiftSemitones >= -PITCH_RATIO_RANGE && pitchShiftSemitones <= PITCH_RATIO_RANGE)
+        return ratios[static_cast<size_t>(pitchShiftSemitones + PITCH_RATIO_RANGE)];
     
-    // Determine the actual pitch shift to apply based on the pitch control settings
-    int actualPitchShift = 0;
+    return std::pow(2.0f, pitchShiftSemitones / 12.0f);
+}
+
+DrumPad::TriggerParameters DrumPad::getTriggerParameters(const TriggerEvent& event) const
+{
+    TriggerParameters parameters;
+    parameters.velocity = event.velocity;
     
-    // Apply MIDI pitch if enabled (base note from midiNote)
-    if (midiPitchEnabled)
-    {
-        // For both MIDI-triggered and grid-triggered notes, apply the pitch shift
-        actualPitchShift = pitchShiftSemitones;
-        
-        // Add additional debug logging
-        DebugLogger::log("DrumPad::triggerSampleUnified - MIDI Pitch Enabled with shift: " + 
-                        std::to_string(pitchShiftSemitones) + 
-                        ", midiNote: " + std::to_string(midiNote));
-    }
+    // The pitch shift applies if MIDI pitch is enabled, or if row pitch is enabled for a cell trigger
+    if (midiPitchEnabled || (rowPitchEnabled && event.cellX >= 0 && event.cellY >= 0))
+        parameters.pitchShift = event.pitchShiftSemitones;
     
-    // Apply row-based pitch if enabled (from the pitchShiftSemitones parameter)
-    if (rowPitchEnabled && cellX >= 0 && cellY >= 0)
+    // How far the cell's age is through the modulation range (0 for a new cell or a non-cell trigger)
+    float ageAmount = juce::jlimit(0.0f, 1.0f, static_cast<float>(event.cellAge - 1) / static_cast<float>(AGE_MODULATION_RANGE));
+    
+    // Envelope times are stretched by the age in envelope modulation mode
+    switch (ageModulation)
     {
-        actualPitchShift = pitchShiftSemitones;
-        
-        // Add additional debug logging
-        DebugLogger::log("DrumPad::triggerSampleUnified - Row Pitch Enabled with shift: " + 
-                        std::to_string(pitchShiftSemitones));
+        case AgeModulation::Velocity:
+            parameters.velocity *= 1.0f - 0.75f * ageAmount;
+            break;
+        case AgeModulation::Envelope:
+            parameters.envelopeScale = 1.0f + 3.0f * ageAmount;
+            break;
+        case AgeModulation::Pitch:
+            parameters.pitchShift += juce::roundToInt(12.0f * ageAmount);
+            break;
+        default:
+            break;
     }
     
     // Calculate the playback rate for the pitch shift
-    float pitchRatio = std::pow(2.0f, actualPitchShift / 12.0f);
-    
-    // Track the last played note and velocity
-    lastPlayedNote = midiNote + actualPitchShift;
-    lastPlayedVelocity = velocity;
-    
-    DebugLogger::log("DrumPad::triggerSampleUnified - MIDI Note: " + std::to_string(lastPlayedNote) + 
-                    ", Velocity: " + std::to_string(velocity) + 
-                    ", Pitch Shift: " + std::to_string(actualPitchShift) + 
-                    ", Original Pitch Shift: " + std::to_string(pitchShiftSemitones) +
-                    ", MIDI Pitch Enabled: " + std::to_string(midiPitchEnabled) +
-                    ", Row Pitch Enabled: " + std::to_string(rowPitchEnabled) +
-                    ", Cell: (" + std::to_string(cellX) + "," + std::to_string(cellY) + ")" +
-                    ", Sustain Level: " + std::to_string(envelopeProcessor.getSustainLevel()));
-    
-    // Check if this is a cell-specific trigger
-    bool isCellSpecific = (cellX >= 0 && cellY >= 0);
+    parameters.pitchRatio = getPitchRatio(parameters.pitchShift);
+    return parameters;
+}
+
+bool DrumPad::updateLegatoVoices(const TriggerParameters& parameters, int cellX, int cellY, int sampleOffset)
+{
+    VoicePool& pool = *voicePool;
+    const int numVoices = pool.getNumVoices(poolPad);
     
-    // Check if we're in legato mode and should update existing voices
-    if (legatoMode)
+    // For cell-specific triggers, find the voice for that cell
+    if (cellX >= 0 && cellY >= 0)
     {
-        // For cell-specific triggers, find the voice for that cell
-        if (isCellSpecific)
-        {
-            for (auto& voice : activeVoices)
-            {
-                if (voice.isForCell(cellX, cellY))
-                {
-                    // Update the velocity and playback rate of the voice
-                    voice.setVolume(velocity);
-                    voice.setPlaybackRate(pitchRatio);
-                    
-                    // If the voice is in release phase, reset it to attack phase
-                    // But in legato mode, we want to preserve both envelope and playback position
-                    if (voice.isReleasingState())
-                    {
-                        // Only update the releasing flag but don't reset the envelope
-                        voice.setReleasing(false);
-                        
-                        // Set the envelope parameters
-                        voice.setEnvelopeRates(
-                            envelopeProcessor.getAttackRate(),
-                            envelopeProcessor.getDecayRate(),
-                            envelopeProcessor.getSustainLevel(),
-                            envelopeProcessor.getReleaseRate()
-                        );
-                    }
-                    
-                    // Found and updated an existing voice, so we're done
-                    return;
-                }
-            }
-        }
-        // For non-cell-specific triggers, update all active voices
-        else if (!activeVoices.empty())
+        for (int i = 0; i < numVoices; ++i)
         {
-            for (auto& voice : activeVoices)
+            const int voice = pool.getVoice(poolPad, i);
+            
+            if (pool.isForCell(voice, cellX, cellY))
             {
                 // Update the velocity and playback rate of the voice
-                voice.setVolume(velocity);
-                voice.setPlaybackRate(pitchRatio);
+                pool.gains[voice] = parameters.velocity;
+                pool.rates[voice] = parameters.pitchRatio;
+                
+                // The cell died and was born again before its voice's deferred release: the
+                // voice plays on through the rebirth instead
+                if (pool.releaseOffsets[voice] >= 0 && pool.releaseOffsets[voice] <= sampleOffset)
+                    pool.releaseOffsets[voice] = -1;
                 
-                // If the voice is in release phase, do not reset it to attack phase
-                // In legato mode, we want to preserve both envelope and playback position
-                if (voice.isReleasingState())
+                // If the voice is in release phase, reset it to attack phase
+                // But in legato mode, we want to preserve both envelope and playback position
+                if (pool.releasing[voice])
                 {
-                    // Only update the releasing flag
-                    voice.setReleasing(false);
+                    // Only update the releasing flag but don't reset the envelope
+                    pool.releasing[voice] = false;
+                    
+                    // Set the envelope parameters
+                    pool.envelopeScales[voice] = parameters.envelopeScale;
+                    pool.setEnvelopeRates(
+                        voice,
+                        envelopeProcessor.getAttackRate(),
+                        envelopeProcessor.getDecayRate(),
+                        envelopeProcessor.getSustainLevel(),
+                        envelopeProcessor.getReleaseRate()
+                    );
                 }
+                
+                // Found and updated an existing voice, so we're done
+                return true;
             }
-            
-            // We've updated all existing voices, so we're done
-            return;
         }
+        
+        return false;
     }
     
-    // Create a new voice
-    Voice newVoice;
-    newVoice.setPlaybackPosition(0);
-    newVoice.setPlaybackRate(pitchRatio);
-    newVoice.setVolume(velocity);
+    // For non-cell-specific triggers, update all active voices
+    if (numVoices == 0)
+        return false;
+    
+    for (int i = 0; i < numVoices; ++i)
+    {
+        const int voice = pool.getVoice(poolPad, i);
+        
+        // Update the velocity and playback rate of the voice
+        pool.gains[voice] = parameters.velocity;
+        pool.rates[voice] = parameters.pitchRatio;
+        
+        // If the voice is in release phase, do not reset it to attack phase
+        // In legato mode, we want to preserve both envelope and playback position
+        pool.releasing[voice] = false;
+        
+        // Cancel a deferred release due before this trigger
+        if (pool.releaseOffsets[voice] >= 0 && pool.releaseOffsets[voice] <= sampleOffset)
+            pool.releaseOffsets[voice] = -1;
+    }
     
-    // Set the sample buffer for the voice
-    newVoice.setSampleBuffer(&sampleBuffer);
+    // We've updated all existing voices, so we're done
+    return true;
+}
+
+void DrumPad::startVoice(const TriggerParameters& parameters, int cellX, int cellY, int sampleOffset)
+{
+    // Take a voice from the pad's free list (room is made by the caller); it starts at the
+    // beginning of the sample with its envelope in the attack
+    VoicePool& pool = *voicePool;
+    const int voice = pool.startVoice(poolPad, sampleOffset);
+    if (voice < 0)
+        return;
     
-    // Set the sample rate for the voice
-    newVoice.setSampleRate(currentSampleRate);
+    pool.rates[voice] = parameters.pitchRatio;
+    pool.gains[voice] = parameters.velocity;
     
     // Set the cell coordinates if this is a cell-specific trigger
-    if (isCellSpecific)
+    if (cellX >= 0 && cellY >= 0)
     {
-        newVoice.setCell(cellX, cellY);
+        pool.cellXs[voice] = static_cast<int16_t>(cellX);
+        pool.cellYs[voice] = static_cast<int16_t>(cellY);
     }
     
-    // Get the current ADSR rates from the envelope processor
-    float attackRate = envelopeProcessor.getAttackRate();
-    float decayRate = envelopeProcessor.getDecayRate();
-    float sustainLevel = envelopeProcessor.getSustainLevel();
-    float releaseRate = envelopeProcessor.getReleaseRate();
-    
-    // Set envelope parameters using setEnvelopeRates
-    newVoice.setEnvelopeRates(
-        attackRate,
-        decayRate,
-        sustainLevel,
-        releaseRate
+    // Get the current ADSR rates from the envelope processor (slower for older cells in envelope
+    // mode; the voice keeps its scale when the ADSR parameters change)
+    pool.envelopeScales[voice] = parameters.envelopeScale;
+    pool.setEnvelopeRates(
+        voice,
+        envelopeProcessor.getAttackRate(),
+        envelopeProcessor.getDecayRate(),
+        envelopeProcessor.getSustainLevel(),
+        envelopeProcessor.getReleaseRate()
     );
+}
+
+void DrumPad::triggerSampleUnified(float velocity, int pitchShiftSemitones, int cellX, int cellY, float delayMs, int cellAge)
+{
+    // Note: The delayMs parameter is handled at the processor level through the scheduleSampleWithDelay method.
+    // This function is designed to be called directly for immediate playback or indirectly through the scheduler.
+    juce::ignoreUnused(delayMs);
     
-    // Reset the envelope to ensure it starts from the beginning
-    newVoice.resetEnvelope();
+    if (sampleBuffer.getNumSamples() == 0 || muted)
+        return;
+    
+    TriggerEvent event;
+    event.velocity = velocity;
+    event.pitchShiftSemitones = pitchShiftSemitones;
+    event.cellX = cellX;
+    event.cellY = cellY;
+    event.cellAge = cellAge;
+    
+    const TriggerParameters parameters = getTriggerParameters(event);
+    
+    // Track the last played note and velocity
+    lastPlayedNote = midiNote + parameters.pitchShift;
+    lastPlayedVelocity = parameters.velocity;
+    
+    // Check if we're in legato mode and should update existing voices
+    if (legatoMode && updateLegatoVoices(parameters, cellX, cellY))
+        return;
     
     // Check if we need to remove an old voice due to polyphony limit
-    if (activeVoices.size() >= maxPolyphony)
+    if (voicePool->getNumVoices(poolPad) >= maxPolyphony)
     {
         // Remove the oldest voice
-        activeVoices.erase(activeVoices.begin());
+        voicePool->removeOldestVoices(poolPad, 1);
+    }
+    
+    startVoice(parameters, cellX, cellY);
+}
+
+void DrumPad::triggerBatch(const TriggerEvent* events, int numEvents)
+{
+    if (sampleBuffer.getNumSamples() == 0 || muted || numEvents <= 0)
+        return;
+    
+    VoicePool& pool = *voicePool;
+    TriggerParameters parameters;
+    
+    // Walk the events in order, stealing as each new voice needs room, so a legato update can
+    // only land on a voice that an earlier event has not stolen (voice stealing in the pool moves
+    // at most MAX_POLYPHONY indices and never allocates)
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const TriggerEvent& event = events[i];
+        parameters = getTriggerParameters(event);
+        
+        if (legatoMode && updateLegatoVoices(parameters, event.cellX, event.cellY, event.sampleOffset))
+            continue;
+        
+        if (pool.getNumVoices(poolPad) >= maxPolyphony)
+            pool.removeOldestVoices(poolPad, 1);
+        
+        startVoice(parameters, event.cellX, event.cellY, event.sampleOffset);
     }
     
-    // Add the new voice to the active voices list
-    activeVoices.push_back(newVoice);
+    // Track the last played note and velocity
+    lastPlayedNote = midiNote + parameters.pitchShift;
+    lastPlayedVelocity = parameters.velocity;
 }
 
 void DrumPad::triggerSample(float velocity)
@@ -254,16 +316,18 @@ void DrumPad::updatePitchForCell(int pitchShiftSemitones, int cellX, int cellY)
     // Only update if we have a sample loaded
     if (sampleBuffer.getNumSamples() > 0)
     {
+        VoicePool& pool = *voicePool;
         bool voiceFound = false;
         
         // Find any voices associated with this cell and update their pitch
-        for (auto& voice : activeVoices)
+        for (int i = 0; i < pool.getNumVoices(poolPad); ++i)
         {
-            if (voice.isForCell(cellX, cellY))
+            const int voice = pool.getVoice(poolPad, i);
+            
+            if (pool.isForCell(voice, cellX, cellY))
             {
                 // Calculate playback rate based on pitch shift
-                float pitchRatio = std::pow(2.0f, pitchShiftSemitones / 12.0f);
-                voice.setPlaybackRate(pitchRatio);
+                pool.rates[voice] = getPitchRatio(pitchShiftSemitones);
                 
                 voiceFound = true;
             }
@@ -283,58 +347,69 @@ void DrumPad::updatePitchForCell(int pitchShiftSemitones, int cellX, int cellY)
 void DrumPad::updateVoiceParametersForCell(float velocity, int pitchShiftSemitones, int cellX, int cellY)
 {
     // Calculate the playback rate for the pitch shift
-    float pitchRatio = std::pow(2.0f, pitchShiftSemitones / 12.0f);
+    float pitchRatio = getPitchRatio(pitchShiftSemitones);
+    
+    VoicePool& pool = *voicePool;
     
     // Find the voice for this cell and update its parameters
-    for (auto& voice : activeVoices)
+    for (int i = 0; i < pool.getNumVoices(poolPad); ++i)
     {
-        if (voice.isForCell(cellX, cellY))
+        const int voice = pool.getVoice(poolPad, i);
+        
+        if (pool.isForCell(voice, cellX, cellY))
         {
             // Gently update parameters without resetting envelope or playback position
-            voice.setVolume(velocity);
-            voice.setPlaybackRate(pitchRatio);
-            
-            // Log the update
-            DebugLogger::log("DrumPad::updateVoiceParametersForCell - Updated voice for cell (" + 
-                            std::to_string(cellX) + "," + std::to_string(cellY) + ") - " +
-                            "Velocity: " + std::to_string(velocity) + ", " +
-                            "Pitch Shift: " + std::to_string(pitchShiftSemitones));
+            pool.gains[voice] = velocity;
+            pool.rates[voice] = pitchRatio;
             
             // Found and updated the voice, so we're done
             return;
         }
     }
-    
-    // If we get here, there was no existing voice for this cell
-    // This shouldn't happen in normal operation, but log it just in case
-    DebugLogger::log("DrumPad::updateVoiceParametersForCell - No voice found for cell (" + 
-                    std::to_string(cellX) + "," + std::to_string(cellY) + ")");
 }
 
 void DrumPad::stopSample()
 {
+    VoicePool& pool = *voicePool;
+    
     // Move all active voices to release phase instead of clearing them
-    for (auto& voice : activeVoices)
+    for (int i = 0; i < pool.getNumVoices(poolPad); ++i)
     {
-        if (!voice.isReleasingState())
+        const int voice = pool.getVoice(poolPad, i);
+        
+        if (!pool.releasing[voice])
         {
-            voice.setEnvelopeState(Voice::EnvelopeState::Release);
-            voice.setReleasing(true);
+            pool.envelopeStates[voice] = VoicePool::EnvelopeState::Release;
+            pool.releasing[voice] = true;
         }
     }
 }
 
-void DrumPad::stopSampleForCell(int cellX, int cellY)
+void DrumPad::stopSampleForCell(int cellX, int cellY, int sampleOffset)
 {
     // Find any voices associated with this cell and move them to release phase
+    VoicePool& pool = *voicePool;
     bool voiceFound = false;
     
-    for (auto& voice : activeVoices)
+    for (int i = 0; i < pool.getNumVoices(poolPad); ++i)
     {
-        if (voice.isForCell(cellX, cellY) && !voice.isReleasingState())
+        const int voice = pool.getVoice(poolPad, i);
+        
+        if (pool.isForCell(voice, cellX, cellY) && !pool.releasing[voice])
         {
-            voice.setEnvelopeState(Voice::EnvelopeState::Release);
-            voice.setReleasing(true);
+            if (sampleOffset > 0)
+            {
+                // Released when rendering reaches the offset (the earliest release wins)
+                const int pendingOffset = pool.releaseOffsets[voice];
+                pool.releaseOffsets[voice] = pendingOffset >= 0 ? juce::jmin(pendingOffset, sampleOffset) : sampleOffset;
+            }
+            else
+            {
+                pool.envelopeStates[voice] = VoicePool::EnvelopeState::Release;
+                pool.releasing[voice] = true;
+                pool.releaseOffsets[voice] = -1;
+            }
+            
             voiceFound = true;
         }
     }
@@ -347,130 +422,65 @@ void DrumPad::stopSampleForCell(int cellX, int cellY)
 
 void DrumPad::processAudio(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    if (muted || activeVoices.empty())
+    if (!isPlaying())
         return;
-        
-    // Process each active voice
-    for (auto it = activeVoices.begin(); it != activeVoices.end();)
+    
+    if (muted)
     {
-        if (it->isActive())
-        {
-            it->processBlock(buffer, startSample, numSamples, volume, pan);
-            ++it;
-        }
-        else
-        {
-            // Remove inactive voices
-            it = activeVoices.erase(it);
-        }
+        skipBlock(numSamples);
+        return;
     }
+        
+    // Mix the pad's voices (the pool frees the ones that finish)
+    voicePool->renderPad(poolPad, sampleBuffer, buffer, startSample, numSamples, volume, pan, interpolation);
 }
 
 void DrumPad::renderNextBlock(juce::AudioBuffer<float>& buffer, int startSample, int numSamples)
 {
-    if (muted || activeVoices.empty())
+    if (!isPlaying())
         return;
-        
-    // Process each active voice
-    int activeVoiceCount = 0;
-    for (auto it = activeVoices.begin(); it != activeVoices.end();)
-    {
-        if (it->isActive())
-        {
-            it->processBlock(buffer, startSample, numSamples, volume, pan);
-            ++it;
-            ++activeVoiceCount;
-        }
-        else
-        {
-            // Remove inactive voices
-            it = activeVoices.erase(it);
-        }
-    }
     
-    // Periodically refresh sustained voices
-    if (++refreshCounter >= 1000) // Every ~1000 audio blocks
+    if (muted)
     {
-        refreshCounter = 0;
-        
-        // Refresh any voices in sustain state
-        for (auto& voice : activeVoices)
-        {
-            if (voice.getEnvelopeState() == Voice::EnvelopeState::Sustain)
-            {
-                // Ensure the envelope level is at the correct sustain level
-                voice.setEnvelopeLevel(voice.getSustainLevel());
-                
-                DebugLogger::log("DrumPad: Refreshed sustained voice - Sustain Level: " + 
-                                std::to_string(voice.getSustainLevel()));
-            }
-        }
-    }
-    
-    if (activeVoiceCount > 0 && activeVoiceCount % 10 == 0) {
-        DebugLogger::log("DrumPad::renderNextBlock - Processing " + std::to_string(activeVoiceCount) + 
-                        " active voices with volume: " + std::to_string(volume));
+        skipBlock(numSamples);
+        return;
     }
+        
+    // Mix the pad's voices (the pool frees the ones that finish)
+    voicePool->renderPad(poolPad, sampleBuffer, buffer, startSample, numSamples, volume, pan, interpolation);
 }
 
 void DrumPad::renderNextBlockToBus(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, int outputBus)
 {
-    if (muted || activeVoices.empty())
+    if (!isPlaying())
         return;
     
-    // Only process if this drum pad is assigned to the specified output bus
-    if (this->outputBus != outputBus)
-        return;
-        
-    // Process each active voice
-    int activeVoiceCount = 0;
-    for (auto it = activeVoices.begin(); it != activeVoices.end();)
+    if (muted)
     {
-        if (it->isActive())
-        {
-            it->processBlock(buffer, startSample, numSamples, volume, pan);
-            ++it;
-            ++activeVoiceCount;
-        }
-        else
-        {
-            // Remove inactive voices
-            it = activeVoices.erase(it);
-        }
+        skipBlock(numSamples);
+        return;
     }
     
-    // Periodically refresh sustained voices
-    if (++refreshCounter >= 1000) // Every ~1000 audio blocks
-    {
-        refreshCounter = 0;
+    // Only process if this drum pad is assigned to the specified output bus
+    if (this->outputBus != outputBus)
+        return;
         
-        // Refresh any voices in sustain state
-        for (auto& voice : activeVoices)
-        {
-            if (voice.getEnvelopeState() == Voice::EnvelopeState::Sustain)
-            {
-                // Ensure the envelope level is at the correct sustain level
-                voice.setEnvelopeLevel(voice.getSustainLevel());
-                
-                DebugLogger::log("DrumPad: Refreshed sustained voice - Sustain Level: " + 
-                                std::to_string(voice.getSustainLevel()));
-            }
-        }
-    }
-    
-    if (activeVoiceCount > 0 && activeVoiceCount % 10 == 0) {
-        DebugLogger::log("DrumPad::renderNextBlockToBus - Processing " + std::to_string(activeVoiceCount) + 
-                        " active voices with volume: " + std::to_string(volume) + 
-                        " on output bus: " + std::to_string(outputBus));
-    }
+    // Mix the pad's voices (the pool frees the ones that finish)
+    voicePool->renderPad(poolPad, sampleBuffer, buffer, startSample, numSamples, volume, pan, interpolation);
+}
+
+void DrumPad::skipBlock(int numSamples)
+{
+    // Voices stay where they are, but their pending starts and releases move on with the block
+    voicePool->skipPad(poolPad, numSamples);
 }
 
 void DrumPad::releaseSample()
 {
     // Start release phase for all active voices
-    for (auto& voice : activeVoices)
+    for (int i = 0; i < voicePool->getNumVoices(poolPad); ++i)
     {
-        voice.noteOff();
+        voicePool->noteOff(voicePool->getVoice(poolPad, i));
     }
 }
 
@@ -483,9 +493,10 @@ void DrumPad::setEnvelopeParameters(float attackTimeMs, float decayTimeMs, float
     envelopeProcessor.setReleaseTime(releaseTimeMs);
     
     // Update all active voices with the new envelope settings
-    for (auto& voice : activeVoices)
+    for (int i = 0; i < voicePool->getNumVoices(poolPad); ++i)
     {
-        voice.updateEnvelopeParameters(attackTimeMs, decayTimeMs, sustainLevel, releaseTimeMs);
+        voicePool->setEnvelopeTimes(voicePool->getVoice(poolPad, i), attackTimeMs, decayTimeMs, sustainLevel, releaseTimeMs,
+                                    currentSampleRate);
     }
 }
 
@@ -495,24 +506,25 @@ void DrumPad::releaseResources()
     stopSample();
     
     // Clear active voices
-    activeVoices.clear();
+    voicePool->clearPad(poolPad);
 }
 
 float DrumPad::getCurrentVolumeLevel() const
 {
     // If there are no active voices, return 0
-    if (activeVoices.empty())
+    const int numVoices = voicePool->getNumVoices(poolPad);
+    if (numVoices == 0)
         return 0.0f;
     
-    // Get the most recently added voice (last in the vector)
-    const Voice& mostRecentVoice = activeVoices.back();
+    // Get the most recently added voice (last in the pad's voice list)
+    const int mostRecentVoice = voicePool->getVoice(poolPad, numVoices - 1);
     
     // Calculate the current volume level based on:
     // 1. The voice's envelope level
     // 2. The voice's volume (velocity)
     // 3. The drum pad's volume setting
-    float envelopeLevel = mostRecentVoice.getEnvelopeLevel();
-    float voiceVolume = mostRecentVoice.getVolume();
+    float envelopeLevel = voicePool->envelopeLevels[mostRecentVoice];
+    float voiceVolume = voicePool->gains[mostRecentVoice];
     
     // Combine all factors to get the final volume level
     float volumeLevel = envelopeLevel * voiceVolume * volume;
@@ -1,15 +1,45 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include "Voice.h"
+#include <array>
+#include "VoicePool.h"
 #include "EnvelopeProcessor.h"
 
+// What the age of the triggering cell modulates
+enum class AgeModulation
+{
+    Off = 0,
+    Velocity,   // older cells play softer
+    Envelope,   // older cells get longer attack, decay and release
+    Pitch,      // older cells play higher, up to an octave
+    NumModes
+};
+
+// One trigger of a pad, for DrumPad::triggerBatch()
+struct TriggerEvent
+{
+    float velocity = 1.0f;
+    int pitchShiftSemitones = 0;
+    int cellX = -1;     // -1 if not triggered by a cell
+    int cellY = -1;
+    int cellAge = 0;    // generations the triggering cell has been alive (0 if not a cell)
+    int sampleOffset = 0;   // where in the next rendered block the sample starts
+};
+
 class DrumPad
 {
 public:
+    // Most voices a pad can play at once
+    static const int MAX_POLYPHONY = VoicePool::VOICES_PER_PAD;
+    
+
     DrumPad();
     ~DrumPad();
     
+    // Play the pad's voices from the given pool, in which it is pad padIndex (must be set before
+    // the pad is used)
+    void setVoicePool(VoicePool* pool, int padIndex);
+    
     // Prepare for playback
     void prepareToPlay(double sampleRate, int samplesPerBlock);
     
@@ -32,7 +62,12 @@ public:
     void triggerSampleWithPitchForCell(float velocity, int pitchShiftSemitones, int cellX, int cellY);
     
     // Unified sample triggering function that handles all cases
-    void triggerSampleUnified(float velocity, int pitchShiftSemitones = 0, int cellX = -1, int cellY = -1, float delayMs = 0.0f);
+    // cellAge is the number of generations the triggering cell has been alive (0 if not a cell)
+    void triggerSampleUnified(float velocity, int pitchShiftSemitones = 0, int cellX = -1, int cellY = -1, float delayMs = 0.0f, int cellAge = 0);
+    
+    // Trigger a group of events at once (e.g. every cell of this pad in a generation). Behaves
+    // like calling triggerSampleUnified() for each event in order, each at its own sample offset.
+    void triggerBatch(const TriggerEvent* events, int numEvents);
     
     // Update pitch for a specific cell in the Game of Life grid without retriggering
     void updatePitchForCell(int pitchShiftSemitones, int cellX, int cellY);
@@ -43,8 +78,9 @@ public:
     // Stop all sample playback immediately
     void stopSample();
     
-    // Stop sample playback for a specific cell in the Game of Life grid
-    void stopSampleForCell(int cellX, int cellY);
+    // Stop sample playback for a specific cell in the Game of Life grid, sampleOffset samples
+    // into the next rendered block
+    void stopSampleForCell(int cellX, int cellY, int sampleOffset = 0);
     
     // Process audio for this pad
     void processAudio(juce::AudioBuffer<float>& buffer, int startSample, int numSamples);
@@ -55,6 +91,9 @@ public:
     // Render audio to a specific output bus
     void renderNextBlockToBus(juce::AudioBuffer<float>& buffer, int startSample, int numSamples, int outputBus);
     
+    // Let a block of numSamples go by without rendering the pad (muted, or routed nowhere)
+    void skipBlock(int numSamples);
+    
     // Release a sample (for ADSR envelope)
     void releaseSample();
     
@@ -62,12 +101,13 @@ public:
     void setEnvelopeParameters(float attackTimeMs, float decayTimeMs, float sustainLevel, float releaseTimeMs);
     
     // Getters and setters
-    bool isPlaying() const { return !activeVoices.empty(); }
+    bool isPlaying() const { return voicePool->getNumVoices(poolPad) > 0; }
+    int getNumActiveVoices() const { return voicePool->getNumVoices(poolPad); }
     void setVolume(float newVolume) { volume = newVolume; }
     void setPan(float newPan) { pan = newPan; }
     void setMuted(bool isMuted) { muted = isMuted; }
     void setMidiNote(int note) { midiNote = note; }
-    void setPolyphony(int count) { maxPolyphony = juce::jlimit(1, 16, count); }
+    void setPolyphony(int count) { maxPolyphony = juce::jlimit(1, MAX_POLYPHONY, count); }
     int getPolyphony() const { return maxPolyphony; }
     
     // Output bus setter and getter
@@ -88,6 +128,17 @@ public:
     void setLegatoMode(bool enabled) { legatoMode = enabled; }
     bool isLegatoMode() const { return legatoMode; }
     
+    // Age modulation setters and getters
+    void setAgeModulation(AgeModulation mode) { ageModulation = mode; }
+    AgeModulation getAgeModulation() const { return ageModulation; }
+    
+    // Interpolation used to play the sample at other pitches
+    void setInterpolation(MixKernel::Interpolation newInterpolation) { interpolation = newInterpolation; }
+    MixKernel::Interpolation getInterpolation() const { return interpolation; }
+    
+    // Cell age (in generations) at which age modulation reaches its full amount
+    static const int AGE_MODULATION_RANGE = 16;
+    
     // Get the file path
     juce::String getFilePath() const { return filePath; }
     float getVolume() const { return volume; }
@@ -114,9 +165,39 @@ public:
     const juce::AudioBuffer<float>* getSampleBuffer() const { return &sampleBuffer; }
     
 private:
+    // What an event plays once the pad's pitch and age modulation settings are applied
+    struct TriggerParameters
+    {
+        float velocity = 1.0f;
+        int pitchShift = 0;
+        float pitchRatio = 1.0f;
+        float envelopeScale = 1.0f;
+    };
+    
+    // Pitch shifts within this many semitones use a table of playback rates
+    static const int PITCH_RATIO_RANGE = 48;
+    
+    // Playback rate for a pitch shift
+    static float getPitchRatio(int pitchShiftSemitones);
+    
+    TriggerParameters getTriggerParameters(const TriggerEvent& event) const;
+    
+    // In legato mode, update the voice of the cell (or every voice for a non-cell trigger)
+    // instead of starting a new one, sampleOffset samples into the next rendered block.
+    // Returns false if there was no voice to update.
+    bool updateLegatoVoices(const TriggerParameters& parameters, int cellX, int cellY, int sampleOffset = 0);
+    
+    // Start a new voice, sampleOffset samples into the next rendered block (the caller makes
+    // room for it under the polyphony limit)
+    void startVoice(const TriggerParameters& parameters, int cellX, int cellY, int sampleOffset = 0);
+    
     juce::AudioBuffer<float> sampleBuffer;
     juce::String filePath; // Path to the loaded sample file
-    std::vector<Voice> activeVoices;
+    
+    // The pool holding the pad's voices, and the pad's index in it
+    VoicePool* voicePool = nullptr;
+    int poolPad = 0;
+    
     int maxPolyphony = 4; // Default to 4 voices
     float volume = 0.8f; // Default volume set to 0.8
     float pan = 0.0f;
@@ -124,6 +205,8 @@ private:
     int midiNote = 0;
     double currentSampleRate = 44100.0; // Store the current sample rate
     bool legatoMode = true; // Default to legato mode (current behavior)
+    AgeModulation ageModulation = AgeModulation::Off;
+    MixKernel::Interpolation interpolation = MixKernel::Interpolation::Linear;
     bool midiPitchEnabled = false; // Default to MIDI pitch control disabled
     bool rowPitchEnabled = false; // Default to row-based pitch control disabled
     int outputBus = 0; // Default to main output bus
@@ -135,6 +218,4 @@ private:
     // ADSR envelope processor
     EnvelopeProcessor envelopeProcessor;
     
-    // Counter for refreshing sustained voices
-    int refreshCounter = 0;
 };
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * A compact record of something the audio thread did, for the UI and other observers
+ */
+struct JournalEvent
+{
+    enum class Type : uint8_t
+    {
+        Generation,     // the grid moved on (or was first triggered)
+        Trigger,        // a pad's cells were triggered
+        PadState        // a pad's voice count or output level
+    };
+
+    Type type = Type::Generation;
+    uint8_t pad = 0;
+    int16_t note = 0;           // Trigger: MIDI note of the last trigger (pad note plus pitch shift)
+    float value = 0.0f;         // Trigger: velocity of the last trigger; PadState: output level
+    int32_t count = 0;          // Generation: cells born; Trigger: cells triggered; PadState: active voices
+    int32_t deaths = 0;         // Generation: cells that died
+    uint16_t birthPads = 0;     // Generation: one bit for each pad with a birth
+    uint16_t deathPads = 0;     // Generation: one bit for each pad with a death
+    uint64_t generation = 0;    // Generation the event belongs to
+};
+
+static_assert(std::is_trivially_copyable<JournalEvent>::value, "Journal events are copied through the ring");
+
+/**
+ * Wait-free single-producer, single-consumer ring of JournalEvents.
+ *
+ * The audio thread pushes, one UI timer drains. Neither side ever blocks: when the ring is full
+ * (the editor is closed, or stalled) new events are dropped and counted rather than overwriting
+ * ones the reader may be copying.
+ */
+class EventJournal
+{
+public:
+    static const int CAPACITY = 4096;  // a power of two
+
+    EventJournal() = default;
+
+    // Append an event. Producer (audio thread) only. Returns false if the ring was full.
+    bool push(const JournalEvent& event)
+    {
+        const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - readIndex.load(std::memory_order_acquire) == static_cast<uint32_t>(CAPACITY))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        events[write & MASK] = event;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pass every event pushed so far to callback, oldest first. Consumer only.
+    // Returns the number of events drained.
+    template <typename Callback>
+    int drain(Callback&& callback)
+    {
+        const uint32_t read = readIndex.load(std::memory_order_relaxed);
+        const uint32_t write = writeIndex.load(std::memory_order_acquire);
+
+        for (uint32_t index = read; index != write; ++index)
+            callback(events[index & MASK]);
+
+        readIndex.store(write, std::memory_order_release);
+        return static_cast<int>(write - read);
+    }
+
+    // Events dropped because the ring was full
+    uint32_t getNumDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static const uint32_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+    std::array<JournalEvent, CAPACITY> events {};
+
+    // Each index is written by one side only; kept on separate cache lines
+    alignas(64) std::atomic<uint32_t> writeIndex { 0 };
+    alignas(64) std::atomic<uint32_t> readIndex { 0 };
+    std::atomic<uint32_t> dropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EventJournal)
+};
@@ -2,5 +2,155 @@
 
 GameOfLife::~GameOfLife()
 {
-    // Nothing to clean up
+    pipeline.stop();
+}
+
+void GameOfLife::update()
+{
+    // A cached cycle is replayed without any stepping, so the lookahead is not needed
+    if (grid.isCycleCached())
+    {
+        grid.update();
+    }
+    else
+    {
+        // Restart the lookahead from the edited grid
+        if (seedDirty.exchange(false))
+            pipeline.publishSeed(grid, generation);
+        
+        if (auto* delta = pipeline.findNextFrame(generation))
+        {
+            grid.applyDelta(delta);
+            pipeline.releaseFrame();
+        }
+        else
+        {
+            // The producer has not got this far yet; compute the generation here
+            lookaheadMisses.fetch_add(1, std::memory_order_relaxed);
+            grid.update();
+        }
+    }
+    
+    ++generation;
+    
+    int activeCells = countActiveCells();
+    detectCycle(activeCells);
+    
+    // Every generation gets a snapshot, which also covers edits made before it
+    snapshotDirty = false;
+    snapshots.publish(grid);
+}
+
+void GameOfLife::applyPendingCommands()
+{
+    using GridCommand = GameOfLifeApp::GridCommand;
+    
+    commands.drain([this](const GridCommand& command)
+    {
+        switch (command.type)
+        {
+            case GridCommand::Type::SetCell:
+                setCellState(command.x, command.y, command.state);
+                break;
+            
+            case GridCommand::Type::SetRow:
+            {
+                if (command.y < 0 || command.y >= grid.getHeight())
+                    break;
+                
+                // Only the cells that change are written, so an unchanged row keeps the cycle history
+                bool changed = false;
+                const int width = juce::jmin(grid.getWidth(), GridCommand::MAX_ROW_WORDS * 64);
+                
+                for (int x = 0; x < width; ++x)
+                {
+                    const bool state = ((command.rowCells[static_cast<size_t>(x / 64)] >> (x % 64)) & 1) != 0;
+                    
+                    if (grid.getCellState(x, command.y) != state)
+                    {
+                        grid.setCellState(x, command.y, state);
+                        changed = true;
+                    }
+                }
+                
+                if (changed)
+                    resetCycleDetection();
+                break;
+            }
+            
+            case GridCommand::Type::Clear:
+                initialize(false);
+                break;
+            
+            case GridCommand::Type::Randomize:
+                initialize(true);
+                break;
+        }
+    });
+}
+
+void GameOfLife::publishPendingSnapshot()
+{
+    if (snapshotDirty.exchange(false))
+        snapshots.publish(grid);
+}
+
+void GameOfLife::detectCycle(int activeCells)
+{
+    const uint64_t hash = grid.getStateHash();
+    
+    if (cycleState.load() == CycleState::Evolving)
+    {
+        // An empty grid stays empty, unless the rule has B0 (births with no live neighbours) or
+        // the dying cells of a Generations rule have still to fade; the history decides those
+        const auto& rule = grid.getRule();
+        
+        if (activeCells == 0 && (rule.birth & 1) == 0 && rule.states <= 2)
+        {
+            cycleState = CycleState::Extinct;
+            cyclePeriod = 1;
+        }
+        else
+        {
+            // Search back from the most recent generation; the distance is the period
+            for (int period = 1; period <= historyCount; ++period)
+            {
+                if (stateHistory[(historyHead - period + HISTORY_SIZE) % HISTORY_SIZE] == hash)
+                {
+                    if (period == 1)
+                        cycleState = (activeCells == 0) ? CycleState::Extinct : CycleState::Static;
+                    else
+                        cycleState = CycleState::Oscillating;
+                    
+                    cyclePeriod = period;
+                    break;
+                }
+            }
+        }
+        
+        // Replay the cycle from the cache rather than recomputing it
+        if (cycleState.load() != CycleState::Evolving && cyclePeriod.load() <= GameOfLifeApp::Grid::MAX_CYCLE_PERIOD)
+        {
+            grid.beginCycleReplay(cyclePeriod.load());
+        }
+    }
+    
+    stateHistory[historyHead] = hash;
+    historyHead = (historyHead + 1) % HISTORY_SIZE;
+    historyCount = juce::jmin(historyCount + 1, HISTORY_SIZE);
+}
+
+void GameOfLife::resetCycleDetection()
+{
+    historyHead = 0;
+    historyCount = 0;
+    cycleState = CycleState::Evolving;
+    cyclePeriod = 0;
+    
+    grid.stopCycleReplay();
+    
+    // Frames computed from the old grid no longer apply, and readers have to see the edit
+    seedDirty = true;
+    snapshotDirty = true;
+    outsideEdit = true;
 }
@@ -2,14 +2,27 @@
 
 #include <JuceHeader.h>
 #include <array>
+#include <atomic>
 #include "ParameterManager.h"
-#include "DrumPad.h"
-#include "ScaleUtility.h"
 #include "Grid.h"
-#include "DebugLogger.h"
+#include "GenerationPipeline.h"
+#include "GridCommandQueue.h"
+#include "GridSnapshot.h"
+
+// What the automaton is doing, as found by cycle detection
+enum class CycleState
+{
+    Evolving = 0,   // no repetition found yet
+    Extinct,        // every cell is dead
+    Static,         // still life (period 1)
+    Oscillating     // repeats with a period of 2 or more
+};
 
 /**
- * Implements Conway's Game of Life cellular automaton with audio triggering
+ * Implements a Life-like cellular automaton (Conway's Game of Life by default) with audio triggering
+ *
+ * Only the audio thread changes the grid. The UI reads published snapshots and sends its edits
+ * through postCommand().
  */
 class GameOfLife
 {
@@ -17,7 +30,8 @@ public:
     // Constructor
     GameOfLife(ParameterManager* pm) : parameterManager(pm)
     {
-        // Grid is initialized in its constructor
+        // Grid is initialized in its constructor; start computing generations ahead
+        pipeline.start();
     }
     
     // Destructor
@@ -27,25 +41,52 @@ public:
     void initialize(bool randomize = false)
     {
         grid.initialize(randomize);
+        resetCycleDetection();
     }
     
     // Initialize the grid with a specific density (0.0-1.0)
     void initializeWithDensity(float density)
     {
         grid.initializeWithDensity(density);
+        resetCycleDetection();
     }
     
-    // Update the grid to the next generation
-    void update()
+    // Restart the random sequence used by initialize() and initializeWithDensity()
+    void setRandomSeed(uint64_t seed)
     {
-        DebugLogger::log("GameOfLife::update - Updating grid to next generation");
-        grid.update();
-        
-        // Log the number of active cells after update
-        int activeCells = countActiveCells();
-        DebugLogger::log("GameOfLife::update - Active cells after update: " + std::to_string(activeCells));
+        grid.setRandomSeed(seed);
     }
     
+    // Change the grid dimensions, keeping the cells that fit in the new size
+    void setSize(int width, int height)
+    {
+        if (grid.setSize(width, height))
+            resetCycleDetection();
+    }
+    
+    // Grid dimensions
+    int getWidth() const { return grid.getWidth(); }
+    int getHeight() const { return grid.getHeight(); }
+    
+    // Set the rule used to compute each generation
+    void setRule(const GameOfLifeApp::LifeRule& rule)
+    {
+        if (rule != grid.getRule())
+        {
+            grid.setRule(rule);
+            resetCycleDetection();
+        }
+    }
+    
+    // Update the grid to the next generation
+    void update();
+    
+    // What the automaton is doing (extinct, static, oscillating, or still evolving)
+    CycleState getCycleState() const { return cycleState.load(); }
+    
+    // Period of the detected cycle (0 while evolving)
+    int getCyclePeriod() const { return cyclePeriod.load(); }
+    
     // Get the state of a cell
     bool getCellState(int x, int y) const
     {
@@ -55,13 +96,18 @@ public:
     // Set the state of a cell
     void setCellState(int x, int y, bool state)
     {
-        grid.setCellState(x, y, state);
+        if (grid.getCellState(x, y) != state)
+        {
+            grid.setCellState(x, y, state);
+            resetCycleDetection();
+        }
     }
     
     // Toggle the state of a cell
     void toggleCellState(int x, int y)
     {
         grid.toggleCellState(x, y);
+        resetCycleDetection();
     }
     
     // Check if a cell has just been activated (was inactive in previous state)
@@ -82,182 +128,95 @@ public:
         return grid.wasCellActive(x, y);
     }
     
-    // Check if the grid has been updated
-    bool hasUpdated() const { return grid.hasUpdated(); }
-    
-    // Check for active cells and trigger samples
-    template<typename SampleMapFunc, typename ModeMapFunc>
-    void checkAndTriggerSamples(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                                int numPads,
-                                SampleMapFunc getSampleForColumn,
-                                ModeMapFunc getControlModeForColumn,
-                                int midiNoteOffset = 60);
-    
-    // Update only the pitch of pitched columns without retriggering samples
-    template<typename SampleMapFunc, typename ModeMapFunc>
-    void updatePitchOnly(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                         int numPads,
-                         SampleMapFunc getSampleForColumn,
-                         ModeMapFunc getControlModeForColumn,
-                         int midiNoteOffset = 60);
-    
-    // Check for inactive cells and stop samples
-    template<typename SampleMapFunc>
-    void checkAndStopSamples(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                             int numPads,
-                             SampleMapFunc getSampleForColumn);
-    
-private:
-    ParameterManager* parameterManager;
-    GameOfLifeApp::Grid grid;
-    
-    int countActiveCells() const
+    // Number of generations a live cell has been alive (0 if it is not alive)
+    int getCellAge(int x, int y) const
     {
-        int activeCells = 0;
-        for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
-        {
-            for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-            {
-                if (grid.getCellState(x, y))
-                    activeCells++;
-            }
-        }
-        return activeCells;
+        return grid.getCellAge(x, y);
     }
-};
-
-// Template method implementations
-template<typename SampleMapFunc, typename ModeMapFunc>
-void GameOfLife::checkAndTriggerSamples(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                                        int numPads,
-                                        SampleMapFunc getSampleForColumn,
-                                        ModeMapFunc getControlModeForColumn,
-                                        int midiNoteOffset)
-{
-    // Only process if the grid has been updated
-    if (!grid.hasUpdated())
-        return;
     
-    // Check each cell in the grid
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    // Generations a dying cell of a Generations rule has left (0 if it is not dying)
+    int getDyingState(int x, int y) const
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            // Check if this cell just became active
-            if (grid.cellJustActivated(x, y))
-            {
-                // Get the sample index for this column
-                int sampleIndex = getSampleForColumn(x);
-                
-                // Skip if the sample index is invalid
-                if (sampleIndex < 0 || sampleIndex >= numPads)
-                    continue;
-                
-                // Get the control mode for this column
-                auto controlMode = getControlModeForColumn(x);
-                
-                // Calculate velocity based on y position (higher = louder)
-                float velocity = (float)(y + 1) / (float)ParameterManager::GRID_SIZE;
-                
-                // Trigger the sample based on control mode
-                if (controlMode == ColumnControlMode::Both)
-                {
-                    // Calculate MIDI note based on y position (higher = higher pitch)
-                    int midiNote = midiNoteOffset + y;
-                    
-                    // Convert MIDI note to pitch shift in semitones
-                    int pitchShift = midiNote - 60; // Assuming 60 (C4) is the base note
-                    
-                    // Apply scale correction if needed
-                    MusicalScale scale = parameterManager->getSelectedScale();
-                    pitchShift = ScaleUtility::snapToScale(pitchShift, 0, scale);
-                    
-                    // Trigger the sample with pitch shift
-                    drumPads[sampleIndex].triggerSampleWithPitchForCell(velocity, pitchShift, x, y);
-                }
-                else
-                {
-                    // Default to volume mode
-                    drumPads[sampleIndex].triggerSampleForCell(velocity, x, y);
-                }
-            }
-        }
+        return grid.getDyingState(x, y);
     }
-}
-
-template<typename SampleMapFunc, typename ModeMapFunc>
-void GameOfLife::updatePitchOnly(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                                 int numPads,
-                                 SampleMapFunc getSampleForColumn,
-                                 ModeMapFunc getControlModeForColumn,
-                                 int midiNoteOffset)
-{
-    // Check each cell in the grid
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    
+    // Queue an edit of the grid from the message thread; the grid itself is only changed by the
+    // audio thread, in applyPendingCommands(). Returns false if the queue was full.
+    bool postCommand(const GameOfLifeApp::GridCommand& command) { return commands.push(command); }
+    
+    // Apply the edits queued with postCommand() (audio thread, before the grid is stepped)
+    void applyPendingCommands();
+    
+    // Births, deaths and survivals produced by the last update()
+    const GameOfLifeApp::CellEvent* getEvents() const { return grid.getEvents(); }
+    int getNumEvents() const { return grid.getNumEvents(); }
+    
+    // Publish a snapshot if the grid was edited since the last one (audio thread)
+    void publishPendingSnapshot();
+    
+    // Copy the latest grid snapshot into snapshot if it is newer; safe from any thread
+    bool readSnapshot(GameOfLifeApp::GridSnapshot& snapshot) const { return snapshots.read(snapshot); }
+    
+    // Number of the latest published snapshot, to check for changes without copying
+    uint64_t getSnapshotGeneration() const { return snapshots.getGeneration(); }
+    
+    // Whether the grid was changed from outside the automaton (an edit, a new size or rule, a
+    // reseed) since the last call, so cells may have gone without a Death event (audio thread)
+    bool takeOutsideEdit()
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            // Only process active cells
-            if (grid.getCellState(x, y))
-            {
-                // Get the sample index for this column
-                int sampleIndex = getSampleForColumn(x);
-                
-                // Skip if the sample index is invalid
-                if (sampleIndex < 0 || sampleIndex >= numPads)
-                    continue;
-                
-                // Get the control mode for this column
-                auto controlMode = getControlModeForColumn(x);
-                
-                // Only update pitch for pitch mode columns
-                if (controlMode == ColumnControlMode::Both)
-                {
-                    // Calculate MIDI note based on y position (higher = higher pitch)
-                    int midiNote = midiNoteOffset + y;
-                    
-                    // Convert MIDI note to pitch shift in semitones
-                    int pitchShift = midiNote - 60; // Assuming 60 (C4) is the base note
-                    
-                    // Apply scale correction if needed
-                    MusicalScale scale = parameterManager->getSelectedScale();
-                    pitchShift = ScaleUtility::snapToScale(pitchShift, 0, scale);
-                    
-                    // Update the pitch for this cell
-                    drumPads[sampleIndex].updatePitchForCell(pitchShift, x, y);
-                }
-            }
-        }
+        const bool edited = outsideEdit;
+        outsideEdit = false;
+        return edited;
     }
-}
-
-template<typename SampleMapFunc>
-void GameOfLife::checkAndStopSamples(std::array<DrumPad, ParameterManager::NUM_SAMPLES>& drumPads, 
-                                     int numPads,
-                                     SampleMapFunc getSampleForColumn)
-{
-    // Only process if the grid has been updated
-    if (!grid.hasUpdated())
-        return;
     
-    // Check each cell in the grid
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    // Generations the lookahead had not computed in time, so update() computed them itself
+    uint32_t getNumLookaheadMisses() const { return lookaheadMisses.load(std::memory_order_relaxed); }
+    
+private:
+    ParameterManager* parameterManager;
+    GameOfLifeApp::Grid grid;
+    
+    // Computes the next generations on a background thread
+    GameOfLifeApp::GenerationPipeline pipeline;
+    
+    // Generations computed since the start (wraps), used to match lookahead frames
+    uint32_t generation = 0;
+    
+    // Set when the grid is changed from outside the automaton, so the lookahead is reseeded
+    std::atomic<bool> seedDirty { true };
+    
+    // Set with seedDirty, and cleared by takeOutsideEdit() (audio thread only)
+    bool outsideEdit = false;
+    
+    // Lookahead frames that were not ready when needed
+    std::atomic<uint32_t> lookaheadMisses { 0 };
+    
+    // Edits from the UI, waiting for the audio thread
+    GameOfLifeApp::GridCommandQueue commands;
+    
+    // Immutable copies of the grid for the UI, and whether an edit still needs publishing
+    GameOfLifeApp::GridSnapshotPublisher snapshots;
+    std::atomic<bool> snapshotDirty { true };
+    
+    // Number of generation hashes remembered for cycle detection
+    static const int HISTORY_SIZE = 128;
+    
+    // Hashes of the most recent generations (a ring buffer, newest at historyHead - 1)
+    std::array<uint64_t, HISTORY_SIZE> stateHistory {};
+    int historyHead = 0;
+    int historyCount = 0;
+    
+    std::atomic<CycleState> cycleState { CycleState::Evolving };
+    std::atomic<int> cyclePeriod { 0 };
+    
+    // Look up the new generation in the history, and cache the cycle for replay once found
+    void detectCycle(int activeCells);
+    
+    // Forget the history after the grid has been changed from outside the automaton
+    void resetCycleDetection();
+    
+    int countActiveCells() const
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            // Check if this cell just became inactive
-            if (grid.cellJustDeactivated(x, y))
-            {
-                // Get the sample index for this column
-                int sampleIndex = getSampleForColumn(x);
-                
-                // Skip if the sample index is invalid
-                if (sampleIndex < 0 || sampleIndex >= numPads)
-                    continue;
-                
-                // Stop the sample for this cell
-                drumPads[sampleIndex].stopSampleForCell(x, y);
-            }
-        }
+        return grid.countLiveCells();
     }
-}
+};
@@ -0,0 +1,190 @@
+#include "GenerationPipeline.h"
+
+namespace GameOfLifeApp {
+
+// How long the producer sleeps when the lookahead is full or there is no seed yet
+static const int PRODUCER_IDLE_MS = 2;
+
+GenerationPipeline::GenerationPipeline() : juce::Thread("Generation Lookahead"),
+                                           frames(static_cast<size_t>(LOOKAHEAD_GENERATIONS + 1))
+{
+}
+
+GenerationPipeline::~GenerationPipeline()
+{
+    stop();
+}
+
+void GenerationPipeline::start()
+{
+    startThread();
+}
+
+void GenerationPipeline::stop()
+{
+    stopThread(1000);
+}
+
+void GenerationPipeline::publishSeed(const Grid& grid, uint32_t generation)
+{
+    // Odd sequence: the producer must not trust what it reads until the write is finished
+    const uint32_t sequence = seedSequence.load(std::memory_order_relaxed);
+    seedSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    seed.width = grid.getWidth();
+    seed.height = grid.getHeight();
+    seed.rule = grid.getRule().pack();
+    seed.generation = generation;
+    grid.storeCells(seed.cells.data());
+
+    // Dying cells decide where a Generations rule can give birth
+    if (grid.getRule().isGenerations())
+        std::copy(grid.getDyingStates(), grid.getDyingStates() + seed.width * seed.height, seed.dyingStates.begin());
+
+    seedSequence.store(sequence + 2, std::memory_order_release);
+    epoch = (sequence + 2) / 2;
+}
+
+const GenerationPipeline::Word* GenerationPipeline::findNextFrame(uint32_t generation)
+{
+    while (fifo.getNumReady() > 0)
+    {
+        const Frame& frame = getReadyFrame(0);
+
+        if (frame.epoch == epoch && frame.generation == generation + 1)
+            return frame.delta.data();
+
+        // Computed from an older seed, or for a generation the consumer has already passed
+        fifo.finishedRead(1);
+    }
+
+    return nullptr;
+}
+
+void GenerationPipeline::releaseFrame()
+{
+    fifo.finishedRead(1);
+}
+
+int GenerationPipeline::getNumFramesAhead() const
+{
+    const int numReady = fifo.getNumReady();
+
+    if (numReady == 0)
+        return 0;
+
+    // Only count frames that follow on from the next one
+    const uint32_t nextGeneration = getReadyFrame(0).generation;
+    int count = 0;
+
+    while (count + 1 < numReady)
+    {
+        const Frame& frame = getReadyFrame(count + 1);
+
+        if (frame.epoch != epoch || frame.generation != nextGeneration + static_cast<uint32_t>(count + 1))
+            break;
+
+        ++count;
+    }
+
+    return count;
+}
+
+const GenerationPipeline::Word* GenerationPipeline::peekFrame(int index) const
+{
+    jassert(index >= 0 && index < getNumFramesAhead());
+    return getReadyFrame(index + 1).delta.data();
+}
+
+const GenerationPipeline::Frame& GenerationPipeline::getReadyFrame(int index) const
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToRead(index + 1, start1, size1, start2, size2);
+
+    const int slot = (index < size1) ? start1 + index : start2 + (index - size1);
+    return frames[static_cast<size_t>(slot)];
+}
+
+void GenerationPipeline::run()
+{
+    uint32_t producerEpoch = 0;
+
+    while (!threadShouldExit())
+    {
+        // A new seed replaces whatever the producer was working from
+        const uint32_t sequence = seedSequence.load(std::memory_order_acquire);
+        if (sequence / 2 != producerEpoch && (sequence & 1) == 0)
+            producerEpoch = loadSeed();
+
+        if (producerEpoch != 0 && fifo.getNumFree() > 0)
+        {
+            produceFrame(producerEpoch);
+            continue;
+        }
+
+        wait(PRODUCER_IDLE_MS);
+    }
+}
+
+uint32_t GenerationPipeline::loadSeed()
+{
+    uint32_t sequence;
+
+    // Sequence lock read: copy, then retry if the consumer published again meanwhile
+    for (;;)
+    {
+        sequence = seedSequence.load(std::memory_order_acquire);
+
+        if ((sequence & 1) == 0)
+        {
+            producerSeed = seed;
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (seedSequence.load(std::memory_order_relaxed) == sequence)
+                break;
+        }
+
+        juce::Thread::yield();
+    }
+
+    producerGrid.setSize(producerSeed.width, producerSeed.height);
+    producerGrid.setRule(LifeRule::unpack(producerSeed.rule));
+    producerGrid.loadCells(producerSeed.cells.data(), producerSeed.dyingStates.data());
+
+    producerCells = producerSeed.cells;
+    producerGeneration = producerSeed.generation;
+
+    return sequence / 2;
+}
+
+void GenerationPipeline::produceFrame(uint32_t producerEpoch)
+{
+    int start1, size1, start2, size2;
+    fifo.prepareToWrite(1, start1, size1, start2, size2);
+
+    if (size1 == 0)
+        return;
+
+    Frame& frame = frames[static_cast<size_t>(start1)];
+
+    producerGrid.update();
+
+    // The delta is the XOR of consecutive generations; the new generation is kept for the next one
+    const int stateSize = producerGrid.getHeight() * producerGrid.getWordsPerRow();
+    producerGrid.storeCells(frame.delta.data());
+
+    for (int i = 0; i < stateSize; ++i)
+    {
+        const size_t index = static_cast<size_t>(i);
+        frame.delta[index] ^= producerCells[index];
+        producerCells[index] ^= frame.delta[index];
+    }
+
+    frame.epoch = producerEpoch;
+    frame.generation = ++producerGeneration;
+
+    fifo.finishedWrite(1);
+}
+
+} // namespace GameOfLifeApp
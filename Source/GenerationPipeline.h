@@ -0,0 +1,109 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "ParameterManager.h"
+#include "Grid.h"
+
+namespace GameOfLifeApp {
+
+/**
+ * Computes generations ahead of the audio thread on a background thread.
+ *
+ * The consumer (the audio thread) publishes a seed - the cells, rule and generation number -
+ * whenever the grid changes other than by moving to the next generation; each seed starts a new
+ * epoch. The producer thread steps its own copy of the grid from the latest seed and pushes one
+ * delta frame (current XOR next generation) per generation into a single-producer /
+ * single-consumer FIFO, staying up to LOOKAHEAD_GENERATIONS ahead. Frames from an older epoch
+ * are dropped by the consumer, which computes the generation itself if no frame is ready.
+ */
+class GenerationPipeline : private juce::Thread
+{
+public:
+    using Word = Grid::Word;
+
+    // Number of generations computed ahead of the consumer
+    static const int LOOKAHEAD_GENERATIONS = 8;
+
+    // Words in one stored generation of the largest grid
+    static const int MAX_STATE_WORDS = ParameterManager::MAX_GRID_SIZE * BitBoard<0, 0>::MAX_WORDS_PER_ROW;
+
+    GenerationPipeline();
+    ~GenerationPipeline() override;
+
+    // Start and stop the producer thread
+    void start();
+    void stop();
+
+    // Make the grid the new starting point for the producer; frames computed from older seeds
+    // are dropped. Consumer thread only.
+    void publishSeed(const Grid& grid, uint32_t generation);
+
+    // The delta that takes the grid from generation to generation + 1, or nullptr if it has not
+    // been computed yet. Stale frames are discarded. A returned delta stays valid until
+    // releaseFrame() is called. Consumer thread only.
+    const Word* findNextFrame(uint32_t generation);
+
+    // Hand the frame returned by findNextFrame() back to the producer
+    void releaseFrame();
+
+    // Number of consecutive frames of the current epoch ready after the next one, and access
+    // to them (0 is the frame after next), so future generations can be looked at early.
+    // Consumer thread only, after a successful findNextFrame().
+    int getNumFramesAhead() const;
+    const Word* peekFrame(int index) const;
+
+private:
+    struct Frame
+    {
+        uint32_t epoch = 0;
+        uint32_t generation = 0;
+        std::array<Word, MAX_STATE_WORDS> delta {};
+    };
+
+    struct Seed
+    {
+        int width = ParameterManager::GRID_SIZE;
+        int height = ParameterManager::GRID_SIZE;
+        uint32_t rule = 0;
+        uint32_t generation = 0;
+        std::array<Word, MAX_STATE_WORDS> cells {};
+        std::array<uint8_t, ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE> dyingStates {};
+    };
+
+    void run() override;
+
+    // Copy the latest seed into the producer's grid (retrying if it is being rewritten)
+    // Returns the seed's epoch
+    uint32_t loadSeed();
+
+    // Compute the next generation of the producer's grid into the next free frame
+    void produceFrame(uint32_t epoch);
+
+    // Frame at a position in the FIFO, counted from the oldest unread one
+    const Frame& getReadyFrame(int index) const;
+
+    // Lookahead frames (one slot more than the lookahead, as the FIFO keeps one free)
+    juce::AbstractFifo fifo { LOOKAHEAD_GENERATIONS + 1 };
+    std::vector<Frame> frames;
+
+    // The seed, guarded by a sequence lock: the count is odd while the consumer writes it, and
+    // half the count is the epoch
+    Seed seed;
+    std::atomic<uint32_t> seedSequence { 0 };
+
+    // Epoch of the last published seed (consumer side)
+    uint32_t epoch = 0;
+
+    // Producer state: its own grid, and the generation it last produced
+    Grid producerGrid;
+    Seed producerSeed;
+    std::array<Word, MAX_STATE_WORDS> producerCells {};
+    uint32_t producerGeneration = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GenerationPipeline)
+};
+
+} // namespace GameOfLifeApp
@@ -2,216 +2,465 @@
 
 namespace GameOfLifeApp {
 
-Grid::Grid() : gridHasUpdated(false)
+static_assert(BitBoard<0, 0>::MAX_WIDTH == ParameterManager::MAX_GRID_SIZE
+              && BitBoard<0, 0>::MAX_HEIGHT == ParameterManager::MAX_GRID_SIZE,
+              "Runtime-sized grid engine must cover the full parameter range");
+
+Grid::Grid() : events(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE)),
+               cellAges(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE)),
+               dyingStates(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE)),
+               dyingMask(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * BitBoard<0, 0>::MAX_WORDS_PER_ROW)),
+               randomCells(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * BitBoard<0, 0>::MAX_WORDS_PER_ROW)),
+               cycleCache(static_cast<size_t>(MAX_CYCLE_PERIOD * ParameterManager::MAX_GRID_SIZE
+                                              * BitBoard<0, 0>::MAX_WORDS_PER_ROW))
 {
     // Initialize grid to all cells dead
     initialize(false);
 }
 
-void Grid::initialize(bool randomize)
+GridEngineBase* Grid::getEngineForSize(int width, int height)
 {
-    // Clear the grid first
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    if (width == height)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
+        switch (width)
         {
-            grid[y][x] = false;
-            nextGrid[y][x] = false;
-            previousGrid[y][x] = false;
+            case 16:  return &engine16;
+            case 32:  return &engine32;
+            case 64:  return &engine64;
+            case 128: return &engine128;
+            case 256: return &engine256;
+            default:  break;
         }
     }
     
-    // If randomize is true, set random cells to alive
-    if (randomize)
+    return &dynamicEngine;
+}
+
+bool Grid::setSize(int width, int height)
+{
+    width = juce::jlimit(ParameterManager::MIN_GRID_SIZE, ParameterManager::MAX_GRID_SIZE, width);
+    height = juce::jlimit(ParameterManager::MIN_GRID_SIZE, ParameterManager::MAX_GRID_SIZE, height);
+    
+    if (width == getWidth() && height == getHeight())
+        return false;
+    
+    GridEngineBase* oldEngine = engine;
+    GridEngineBase* newEngine = getEngineForSize(width, height);
+    
+    // The runtime-sized engine may be resized in place, so keep a copy of its cells first
+    GridEngine<0, 0> resizedCopy;
+    if (oldEngine == &dynamicEngine)
+    {
+        resizedCopy = dynamicEngine;
+        oldEngine = &resizedCopy;
+    }
+    
+    if (newEngine == &dynamicEngine)
+        dynamicEngine.resize(width, height);
+    else
+        newEngine->clear();
+    
+    // Copy the overlapping region of the old grid
+    const int copyWidth = juce::jmin(width, oldEngine->getWidth());
+    const int copyHeight = juce::jmin(height, oldEngine->getHeight());
+    
+    for (int y = 0; y < copyHeight; ++y)
+        for (int x = 0; x < copyWidth; ++x)
+            if (oldEngine->getCell(x, y))
+                newEngine->setCell(x, y, true);
+    
+    engine = newEngine;
+    numEvents = 0;
+    stopCycleReplay();
+    resetCellStates();
+    recomputeStateHash();
+    return true;
+}
+
+void Grid::setRule(const LifeRule& newRule)
+{
+    if (newRule != rule.getRule())
     {
-        auto& random = juce::Random::getSystemRandom();
+        // Dying cells only make sense for the number of states they were counted down from
+        if (newRule.states != rule.getRule().states)
+            clearDyingStates();
         
-        for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
-        {
-            for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-            {
-                // About 25% chance of a cell being alive initially
-                grid[y][x] = (random.nextInt(100) < 25);
-                previousGrid[y][x] = grid[y][x];
-            }
-        }
+        rule = CompiledLifeRule(newRule);
+        
+        // Regions that were stable (or cycling) under the old rule may not be under the new one
+        engine->markAllTilesDirty();
+        stopCycleReplay();
     }
+}
+
+void Grid::initialize(bool randomize)
+{
+    if (randomize)
+    {
+        // About 25% chance of a cell being alive initially
+        fillRandom(0.25f);
+        return;
+    }
+    
+    engine->clear();
+    numEvents = 0;
     
-    gridHasUpdated = true;
+    stopCycleReplay();
+    resetCellStates();
+    recomputeStateHash();
 }
 
 void Grid::initializeWithDensity(float density)
 {
-    // Clamp density to valid range (0.0-1.0)
-    density = juce::jlimit(0.0f, 1.0f, density);
+    // Probability of a cell being alive is determined by density
+    fillRandom(density);
+}
+
+void Grid::fillRandom(float density)
+{
+    const int words = getWordsPerRow();
+    const int bitsInLastWord = getWidth() - (words - 1) * 64;
+    const Word lastWordMask = (bitsInLastWord == 64) ? ~Word(0) : ((Word(1) << bitsInLastWord) - 1);
+    
+    // Whole words are drawn, then the bits beyond the last column are cleared
+    Word* cells = randomCells.data();
     
-    // Clear the grid first
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    for (int y = 0; y < getHeight(); ++y)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            grid[y][x] = false;
-            nextGrid[y][x] = false;
-            previousGrid[y][x] = false;
-        }
+        for (int k = 0; k < words; ++k)
+            *cells++ = random.nextBits(density);
+        
+        cells[-1] &= lastWordMask;
     }
     
-    // Set random cells to alive based on the density
-    auto& random = juce::Random::getSystemRandom();
+    loadCells(randomCells.data());
+}
+
+void Grid::update()
+{
+    const int stateSize = getHeight() * getWordsPerRow();
     
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    if (cyclePeriod > 0 && cycleRecorded == cyclePeriod)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            // Probability of a cell being alive is determined by density
-            grid[y][x] = (random.nextFloat() < density);
-            previousGrid[y][x] = grid[y][x];
-        }
+        // Replay the cached cycle
+        engine->advanceTo(cycleCache.data() + cyclePosition * stateSize);
+        cyclePosition = (cyclePosition + 1) % cyclePeriod;
+    }
+    else
+    {
+        // Compute the next generation; the old generation is kept as the previous grid
+        engine->step(rule);
+        
+        // Dying cells of a Generations rule cannot be born
+        if (hasDyingCells)
+            engine->removeCells(dyingMask.data());
+        
+        // Record the generation while a cycle is being cached
+        if (cyclePeriod > 0)
+            engine->storeCurrent(cycleCache.data() + (cycleRecorded++) * stateSize);
     }
     
-    gridHasUpdated = true;
+    finishGeneration();
 }
 
-void Grid::update()
+void Grid::applyDelta(const Word* delta)
 {
-    // Save current grid state to previous grid
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    engine->advanceByDelta(delta);
+    
+    // The frame has already kept births out of the dying cells, but their tiles must still be
+    // recomputed if a later generation is computed here
+    if (hasDyingCells)
+        engine->removeCells(dyingMask.data());
+    
+    // Keep the cycle cache in step with the generations arriving from outside
+    if (cyclePeriod > 0)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            previousGrid[y][x] = grid[y][x];
-        }
+        if (cycleRecorded < cyclePeriod)
+            engine->storeCurrent(cycleCache.data() + (cycleRecorded++) * getHeight() * getWordsPerRow());
+        else
+            cyclePosition = (cyclePosition + 1) % cyclePeriod;
     }
     
-    // Apply Game of Life rules to calculate next grid state
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    finishGeneration();
+}
+
+void Grid::loadCells(const Word* cells, const uint8_t* states)
+{
+    engine->load(cells);
+    numEvents = 0;
+    
+    stopCycleReplay();
+    resetCellStates();
+    
+    if (states != nullptr && rule.getRule().isGenerations())
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
+        const int width = getWidth();
+        
+        for (int y = 0; y < getHeight(); ++y)
+            for (int x = 0; x < width; ++x)
+                if (states[y * width + x] != 0 && !engine->getCell(x, y))
+                    setDyingState(x, y, states[y * width + x]);
+    }
+    
+    recomputeStateHash();
+}
+
+void Grid::finishGeneration()
+{
+    // Record what changed, so the trigger stage only visits live and changed cells
+    numEvents = engine->collectEvents(events.data());
+    
+    // Births and deaths toggle their cells' keys in the hash
+    for (int i = 0; i < numEvents; ++i)
+        if (events[i].type != CellEvent::Type::Survive)
+            stateHash ^= getCellKey(events[i].x, events[i].y);
+    
+    updateCellStates();
+}
+
+void Grid::updateCellStates()
+{
+    const int width = getWidth();
+    const int words = getWordsPerRow();
+    const LifeRule& currentRule = rule.getRule();
+    
+    // Dying cells count down to dead (before the cells that just died start dying);
+    // setDyingState() flags the cells that are still dying
+    if (hasDyingCells)
+    {
+        hasDyingCells = false;
+        
+        for (int y = 0; y < getHeight(); ++y)
         {
-            int liveNeighbors = countLiveNeighbors(x, y);
-            
-            // Apply Conway's Game of Life rules
-            if (grid[y][x])
+            for (int k = 0; k < words; ++k)
             {
-                // Live cell with fewer than 2 live neighbors dies (underpopulation)
-                // Live cell with more than 3 live neighbors dies (overpopulation)
-                nextGrid[y][x] = (liveNeighbors == 2 || liveNeighbors == 3);
-            }
-            else
-            {
-                // Dead cell with exactly 3 live neighbors becomes alive (reproduction)
-                nextGrid[y][x] = (liveNeighbors == 3);
+                for (Word remaining = dyingMask[static_cast<size_t>(y * words + k)]; remaining != 0; remaining &= remaining - 1)
+                {
+                    const int x = k * 64 + BitOps::lowestSetBit(remaining);
+                    setDyingState(x, y, dyingStates[static_cast<size_t>(y * width + x)] - 1);
+                }
             }
         }
     }
     
-    // Update the current grid with the calculated next state
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    // The events visit every live cell anyway, so ages follow them rather than a sweep of the grid
+    for (int i = 0; i < numEvents; ++i)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
+        const CellEvent& event = events[static_cast<size_t>(i)];
+        uint8_t& age = cellAges[static_cast<size_t>(event.y * width + event.x)];
+        
+        switch (event.type)
         {
-            grid[y][x] = nextGrid[y][x];
+            case CellEvent::Type::Birth:
+                age = 1;
+                break;
+            case CellEvent::Type::Survive:
+                age = static_cast<uint8_t>(age < 255 ? age + 1 : age);
+                break;
+            case CellEvent::Type::Death:
+                age = 0;
+                if (currentRule.isGenerations())
+                    setDyingState(event.x, event.y, currentRule.getDyingGenerations());
+                break;
         }
     }
+}
+
+void Grid::resetCellStates()
+{
+    const int width = getWidth();
     
-    gridHasUpdated = true;
+    for (int y = 0; y < getHeight(); ++y)
+        for (int x = 0; x < width; ++x)
+            cellAges[static_cast<size_t>(y * width + x)] = engine->getCell(x, y) ? 1 : 0;
+    
+    clearDyingStates();
+}
+
+void Grid::resetCellState(int x, int y, bool alive)
+{
+    cellAges[static_cast<size_t>(y * getWidth() + x)] = alive ? 1 : 0;
+    setDyingState(x, y, 0);
+}
+
+void Grid::clearDyingStates()
+{
+    std::fill(dyingStates.begin(), dyingStates.end(), uint8_t(0));
+    std::fill(dyingMask.begin(), dyingMask.end(), Word(0));
+    hasDyingCells = false;
+    dyingHash = 0;
 }
 
-int Grid::countLiveNeighbors(int x, int y) const
+void Grid::setDyingState(int x, int y, int state)
 {
-    int count = 0;
+    uint8_t& dying = dyingStates[static_cast<size_t>(y * getWidth() + x)];
+    Word& mask = dyingMask[static_cast<size_t>(y * getWordsPerRow() + x / 64)];
+    
+    if (dying != 0)
+        dyingHash ^= getDyingKey(x, y, dying);
+    
+    dying = static_cast<uint8_t>(state);
     
-    // Check all 8 neighboring cells
-    for (int dy = -1; dy <= 1; ++dy)
+    if (state != 0)
     {
-        for (int dx = -1; dx <= 1; ++dx)
-        {
-            // Skip the cell itself
-            if (dx == 0 && dy == 0)
-                continue;
-            
-            // Calculate neighbor coordinates with wrapping
-            int nx = (x + dx + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-            int ny = (y + dy + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-            
-            // Count live neighbors
-            if (grid[ny][nx])
-                count++;
-        }
+        dyingHash ^= getDyingKey(x, y, state);
+        mask |= Word(1) << (x % 64);
+        hasDyingCells = true;
     }
+    else
+    {
+        mask &= ~(Word(1) << (x % 64));
+    }
+}
+
+int Grid::getCellAge(int x, int y) const
+{
+    // Ensure coordinates are within bounds
+    wrapCoordinates(x, y);
+    
+    return cellAges[static_cast<size_t>(y * getWidth() + x)];
+}
+
+int Grid::getDyingState(int x, int y) const
+{
+    // Ensure coordinates are within bounds
+    wrapCoordinates(x, y);
     
-    return count;
+    return dyingStates[static_cast<size_t>(y * getWidth() + x)];
+}
+
+void Grid::wrapCoordinates(int& x, int& y) const
+{
+    const int width = getWidth();
+    const int height = getHeight();
+    
+    x = ((x % width) + width) % width;
+    y = ((y % height) + height) % height;
 }
 
 bool Grid::getCellState(int x, int y) const
 {
     // Ensure coordinates are within bounds
-    x = (x + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-    y = (y + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
+    wrapCoordinates(x, y);
     
-    return grid[y][x];
+    return engine->getCell(x, y);
 }
 
 void Grid::setCellState(int x, int y, bool state)
 {
     // Ensure coordinates are within bounds
-    x = (x + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-    y = (y + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
+    wrapCoordinates(x, y);
     
-    grid[y][x] = state;
-    previousGrid[y][x] = state; // Update previous grid to avoid false triggers
-    gridHasUpdated = true;
+    if (engine->getCell(x, y) != state)
+    {
+        stateHash ^= getCellKey(x, y);
+        stopCycleReplay();
+    }
+    
+    // Also updates the previous grid to avoid false triggers
+    engine->setCell(x, y, state);
+    resetCellState(x, y, state);
 }
 
 void Grid::toggleCellState(int x, int y)
 {
     // Ensure coordinates are within bounds
-    x = (x + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-    y = (y + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
+    wrapCoordinates(x, y);
+    
+    stateHash ^= getCellKey(x, y);
+    stopCycleReplay();
     
-    grid[y][x] = !grid[y][x];
-    previousGrid[y][x] = grid[y][x]; // Update previous grid to avoid false triggers
-    gridHasUpdated = true;
+    // Also updates the previous grid to avoid false triggers
+    engine->setCell(x, y, !engine->getCell(x, y));
+    resetCellState(x, y, engine->getCell(x, y));
 }
 
 bool Grid::cellJustActivated(int x, int y) const
 {
     // Ensure coordinates are within bounds
-    x = (x + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
-    y = (y + ParameterManager::GRID_SIZE) % ParameterManager::GRID_SIZE;
+    wrapCoordinates(x, y);
     
     // Cell is active now but was not active in the previous grid
-    return grid[y][x] && !previousGrid[y][x];
+    return ((getBirthMask(y, x / 64) >> (x % 64)) & 1) != 0;
 }
 
 bool Grid::cellJustDeactivated(int x, int y) const
 {
     // Check bounds
-    if (x < 0 || x >= ParameterManager::GRID_SIZE || y < 0 || y >= ParameterManager::GRID_SIZE)
+    if (x < 0 || x >= getWidth() || y < 0 || y >= getHeight())
         return false;
         
     // Cell was active in previous grid but is now inactive
-    return previousGrid[y][x] && !grid[y][x];
+    return ((getDeathMask(y, x / 64) >> (x % 64)) & 1) != 0;
 }
 
 bool Grid::wasCellActive(int x, int y) const
 {
     // Check bounds
-    if (x < 0 || x >= ParameterManager::GRID_SIZE || y < 0 || y >= ParameterManager::GRID_SIZE)
+    if (x < 0 || x >= getWidth() || y < 0 || y >= getHeight())
         return false;
         
     // Return the state of the cell in the previous grid
-    return previousGrid[y][x];
+    return engine->getPreviousCell(x, y);
+}
+
+Grid::Word Grid::getBirthMask(int y, int wordIndex) const
+{
+    return engine->getCurrentWord(y, wordIndex) & ~engine->getPreviousWord(y, wordIndex);
+}
+
+Grid::Word Grid::getDeathMask(int y, int wordIndex) const
+{
+    return engine->getPreviousWord(y, wordIndex) & ~engine->getCurrentWord(y, wordIndex);
+}
+
+void Grid::beginCycleReplay(int period)
+{
+    jassert(period > 0 && period <= MAX_CYCLE_PERIOD);
+    
+    cyclePeriod = juce::jlimit(1, MAX_CYCLE_PERIOD, period);
+    cycleRecorded = 0;
+    cyclePosition = 0;
 }
 
-bool Grid::hasUpdated() const
+void Grid::stopCycleReplay()
 {
-    bool updated = gridHasUpdated;
-    // We need to modify gridHasUpdated even in a const method
-    // This is a logical const-ness situation where we're not changing the
-    // observable state of the object, just an internal flag
-    const_cast<Grid*>(this)->gridHasUpdated = false; // Reset the flag
-    return updated;
+    if (cyclePeriod == 0)
+        return;
+    
+    cyclePeriod = 0;
+    
+    // The engine's tile tracking was not kept up to date during the replay
+    engine->markAllTilesDirty();
+}
+
+uint64_t Grid::getCellKey(int x, int y)
+{
+    // SplitMix64 finaliser of the cell index, so the keys need no table
+    uint64_t z = (static_cast<uint64_t>(y) << 16 | static_cast<uint64_t>(x)) + 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t Grid::getDyingKey(int x, int y, int state)
+{
+    // Rows never exceed 256, so the state can share the row field without colliding with a cell key
+    return getCellKey(x, y + (state << 8));
+}
+
+void Grid::recomputeStateHash()
+{
+    stateHash = 0;
+    
+    for (int y = 0; y < getHeight(); ++y)
+    {
+        for (int k = 0; k < getWordsPerRow(); ++k)
+        {
+            for (Word word = engine->getCurrentWord(y, k); word != 0; word &= word - 1)
+                stateHash ^= getCellKey(k * 64 + BitOps::lowestSetBit(word), y);
+        }
+    }
 }
 
 } // namespace GameOfLifeApp
@@ -1,28 +1,66 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <vector>
 #include "ParameterManager.h"
+#include "GridEngine.h"
+#include "RandomGenerator.h"
 
 namespace GameOfLifeApp {
 
 /**
- * Represents a cellular automaton grid with Game of Life rules
+ * Represents a cellular automaton grid with Life-like (B/S) rules
  */
 class Grid
 {
 public:
+    using Word = GridEngineBase::Word;
+    
+    // Longest cycle that can be cached for replay
+    static const int MAX_CYCLE_PERIOD = 64;
+    
     Grid();
     ~Grid() = default;
     
-    // Initialize the grid
+    // Change the grid dimensions, keeping the cells that fit in the new size
+    // Returns true if the size changed
+    bool setSize(int width, int height);
+    
+    // Grid dimensions
+    int getWidth() const { return engine->getWidth(); }
+    int getHeight() const { return engine->getHeight(); }
+    int getWordsPerRow() const { return engine->getWordsPerRow(); }
+    
+    // Set the rule used to compute each generation (Conway's B3/S23 by default)
+    void setRule(const LifeRule& newRule);
+    
+    // Get the current rule
+    const LifeRule& getRule() const { return rule.getRule(); }
+    
+    // Initialize the grid (randomly, about 25% of the cells alive, if randomize is true)
     void initialize(bool randomize = false);
     
-    // Initialize the grid with a specific density (0.0-1.0)
+    // Initialize the grid with a specific density (0.0-1.0, rounded to a multiple of 1/256)
     void initializeWithDensity(float density);
     
+    // Restart the random sequence used to initialize the grid: the same seed followed by the
+    // same initializations always gives the same grids
+    void setRandomSeed(uint64_t seed) { random.setSeed(seed); }
+    
     // Update the grid to the next generation
     void update();
     
+    // Move to the next generation by applying a precomputed delta (current XOR next generation,
+    // laid out like storeCells()), e.g. a frame computed ahead by the GenerationPipeline
+    void applyDelta(const Word* delta);
+    
+    // Copy the current generation into cells (getHeight() * getWordsPerRow() words, row by row)
+    void storeCells(Word* cells) const { engine->storeCurrent(cells); }
+    
+    // Replace the grid contents with stored cells (laid out like storeCells()), and optionally
+    // the dying states of a Generations rule (laid out like getDyingStates())
+    void loadCells(const Word* cells, const uint8_t* states = nullptr);
+    
     // Get the state of a cell
     bool getCellState(int x, int y) const;
     
@@ -41,20 +79,123 @@ public:
     // Check if a cell was active in the previous grid
     bool wasCellActive(int x, int y) const;
     
-    // Check if the grid has been updated since last check
-    bool hasUpdated() const;
+    // Bit masks of the cells in one word of a row that were born / died in the last generation
+    // (bit n of word k is column k * 64 + n)
+    Word getBirthMask(int y, int wordIndex = 0) const;
+    Word getDeathMask(int y, int wordIndex = 0) const;
+    
+    // Count the live cells in the current generation
+    int countLiveCells() const { return engine->countLiveCells(); }
+    
+    // Number of generations a live cell has been alive (1 when just born, saturating at 255),
+    // or 0 for a cell that is not alive
+    int getCellAge(int x, int y) const;
+    
+    // Generations a dying cell of a Generations rule has left before it is dead (0 if not dying)
+    int getDyingState(int x, int y) const;
+    
+    // Dying states of every cell, getWidth() bytes per row
+    const uint8_t* getDyingStates() const { return dyingStates.data(); }
+    
+    // Births, deaths and survivals produced by the last update(), in row order
+    // (the list is emptied when the grid is initialized or resized)
+    const CellEvent* getEvents() const { return events.data(); }
+    int getNumEvents() const { return numEvents; }
+    
+    // Zobrist hash of the current generation, updated incrementally from the events and edits
+    // (and including the dying cells of a Generations rule)
+    uint64_t getStateHash() const { return stateHash ^ dyingHash; }
+    
+    // The grid is known to repeat with the given period (1 to MAX_CYCLE_PERIOD): record the next
+    // period generations, then replay them from the cache instead of computing them.
+    // Any edit, resize or rule change stops the replay.
+    void beginCycleReplay(int period);
+    
+    // Stop recording or replaying a cycle and go back to computing generations
+    void stopCycleReplay();
+    
+    // Check if a cycle is being recorded or replayed
+    bool isReplayingCycle() const { return cyclePeriod > 0; }
+    
+    // Check if the whole cycle has been recorded, so update() only replays it
+    bool isCycleCached() const { return cyclePeriod > 0 && cycleRecorded == cyclePeriod; }
     
 private:
-    // Count the number of live neighbors for a cell
-    int countLiveNeighbors(int x, int y) const;
+    // Zobrist key of a cell
+    static uint64_t getCellKey(int x, int y);
+    
+    // Hash the current generation from scratch
+    void recomputeStateHash();
+    
+    // Collect the events of a new generation and update the hash from them
+    void finishGeneration();
+    
+    // Age the live cells and count down the dying ones after a generation
+    void updateCellStates();
+    
+    // Set every cell's age from its state and clear the dying states (after the grid is replaced)
+    void resetCellStates();
+    
+    // Set a single edited cell's age and clear its dying state
+    void resetCellState(int x, int y, bool alive);
+    
+    // Clear the dying states of every cell
+    void clearDyingStates();
+    
+    // Set the dying state of a cell, keeping the mask and hash in step
+    void setDyingState(int x, int y, int state);
+    
+    // Hash key of a dying cell in a given state
+    static uint64_t getDyingKey(int x, int y, int state);
+
+    // Pick the engine for a grid size (specialised engines for the common square sizes)
+    GridEngineBase* getEngineForSize(int width, int height);
+    
+    // Wrap coordinates onto the grid
+    void wrapCoordinates(int& x, int& y) const;
+    
+    // Replace the grid with random cells, a word at a time
+    void fillRandom(float density);
+    
+    // Engines for each supported size; all are preallocated so resizing never allocates
+    GridEngine<16, 16> engine16;
+    GridEngine<32, 32> engine32;
+    GridEngine<64, 64> engine64;
+    GridEngine<128, 128> engine128;
+    GridEngine<256, 256> engine256;
+    GridEngine<0, 0> dynamicEngine;
+    
+    // The engine for the current grid size
+    GridEngineBase* engine = &engine16;
+    
+    // The rule, compiled to a bitwise formula when it is set
+    CompiledLifeRule rule;
+    
+    // Events of the last generation, preallocated for the largest grid
+    std::vector<CellEvent> events;
+    int numEvents = 0;
+    
+    // Hash of the current generation
+    uint64_t stateHash = 0;
+    
+    // Per-cell ages and dying states, getWidth() bytes per row, preallocated for the largest grid.
+    // The dying cells are also kept as a bit mask (laid out like storeCells()), so births into
+    // them can be cancelled a word at a time.
+    std::vector<uint8_t> cellAges;
+    std::vector<uint8_t> dyingStates;
+    std::vector<Word> dyingMask;
+    bool hasDyingCells = false;
+    uint64_t dyingHash = 0;
     
-    // Grid data - current, next, and previous states
-    bool grid[ParameterManager::GRID_SIZE][ParameterManager::GRID_SIZE];
-    bool nextGrid[ParameterManager::GRID_SIZE][ParameterManager::GRID_SIZE];
-    bool previousGrid[ParameterManager::GRID_SIZE][ParameterManager::GRID_SIZE];
+    // Random cells are drawn into randomCells (preallocated for the largest grid) and loaded
+    RandomGenerator random;
+    std::vector<Word> randomCells;
     
-    // Flag to track if the grid has been updated
-    bool gridHasUpdated;
+    // Generations of the cycle being replayed, preallocated for the largest grid
+    std::vector<Word> cycleCache;
+    int cyclePeriod = 0;      // 0 when no cycle is being replayed
+    int cycleRecorded = 0;    // Generations recorded so far
+    int cyclePosition = 0;    // Next generation to replay
 };
 
 } // namespace GameOfLifeApp
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include "Grid.h"
+
+namespace GameOfLifeApp {
+
+/**
+ * An edit of the grid made outside the audio thread (by the UI), applied by the audio thread
+ */
+struct GridCommand
+{
+    using Word = Grid::Word;
+
+    // Words in one row of the widest grid
+    static const int MAX_ROW_WORDS = BitBoard<0, 0>::MAX_WORDS_PER_ROW;
+
+    enum class Type : uint8_t
+    {
+        SetCell,        // set cell (x, y) to state
+        SetRow,         // set row y to rowCells (bit x % 64 of word x / 64; columns beyond the grid are ignored)
+        Clear,          // kill every cell
+        Randomize       // fill with random cells from the grid's random sequence
+    };
+
+    Type type = Type::Clear;
+    bool state = false;
+    int16_t x = 0;
+    int16_t y = 0;
+    std::array<Word, MAX_ROW_WORDS> rowCells {};
+
+    static GridCommand setCell(int x, int y, bool state)
+    {
+        GridCommand command;
+        command.type = Type::SetCell;
+        command.x = static_cast<int16_t>(x);
+        command.y = static_cast<int16_t>(y);
+        command.state = state;
+        return command;
+    }
+
+    static GridCommand setRow(int y, const Word* cells, int numWords)
+    {
+        GridCommand command;
+        command.type = Type::SetRow;
+        command.y = static_cast<int16_t>(y);
+        std::copy(cells, cells + juce::jmin(numWords, MAX_ROW_WORDS), command.rowCells.begin());
+        return command;
+    }
+
+    static GridCommand clear()
+    {
+        return {};
+    }
+
+    static GridCommand randomize()
+    {
+        GridCommand command;
+        command.type = Type::Randomize;
+        return command;
+    }
+};
+
+static_assert(std::is_trivially_copyable<GridCommand>::value, "Grid commands are copied through the ring");
+
+/**
+ * Wait-free single-producer, single-consumer ring of GridCommands.
+ *
+ * The message thread pushes, the audio thread pops at the start of each block, so the grid is
+ * only ever changed by the thread that steps it. When the ring is full (the audio thread is not
+ * running) new commands are dropped and counted.
+ */
+class GridCommandQueue
+{
+public:
+    static const int CAPACITY = 1024;  // a power of two, room for a whole grid of SetRow commands
+
+    GridCommandQueue() = default;
+
+    // Append a command. Producer (message thread) only. Returns false if the ring was full.
+    bool push(const GridCommand& command)
+    {
+        const uint32_t write = writeIndex.load(std::memory_order_relaxed);
+
+        if (write - readIndex.load(std::memory_order_acquire) == static_cast<uint32_t>(CAPACITY))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        commands[write & MASK] = command;
+        writeIndex.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Pass every command pushed so far to callback, oldest first. Consumer (audio thread) only.
+    // Returns the number of commands drained.
+    template <typename Callback>
+    int drain(Callback&& callback)
+    {
+        const uint32_t read = readIndex.load(std::memory_order_relaxed);
+        const uint32_t write = writeIndex.load(std::memory_order_acquire);
+
+        for (uint32_t index = read; index != write; ++index)
+            callback(commands[index & MASK]);
+
+        readIndex.store(write, std::memory_order_release);
+        return static_cast<int>(write - read);
+    }
+
+    // Commands dropped because the ring was full
+    uint32_t getNumDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static const uint32_t MASK = CAPACITY - 1;
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two");
+
+    std::array<GridCommand, CAPACITY> commands {};
+
+    // Each index is written by one side only; kept on separate cache lines
+    alignas(64) std::atomic<uint32_t> writeIndex { 0 };
+    alignas(64) std::atomic<uint32_t> readIndex { 0 };
+    std::atomic<uint32_t> dropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GridCommandQueue)
+};
+
+} // namespace GameOfLifeApp
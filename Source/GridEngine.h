@@ -0,0 +1,308 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "BitBoard.h"
+#include "LifeRule.h"
+
+namespace GameOfLifeApp {
+
+/**
+ * A cell that changed state (or stayed alive) in the last generation
+ */
+struct CellEvent
+{
+    enum class Type : uint8_t
+    {
+        Birth = 0,  // dead -> alive
+        Death,      // alive -> dead
+        Survive     // alive -> alive
+    };
+
+    uint16_t x;
+    uint16_t y;
+    Type type;
+};
+
+/**
+ * Interface to a double-buffered grid of a particular size.
+ * Grid dispatches to one engine per generation, so the per-cell work
+ * happens inside code specialised for the engine's dimensions.
+ */
+class GridEngineBase
+{
+public:
+    using Word = uint64_t;
+
+    virtual ~GridEngineBase() = default;
+
+    // Grid dimensions
+    virtual int getWidth() const = 0;
+    virtual int getHeight() const = 0;
+    virtual int getWordsPerRow() const = 0;
+
+    // Clear both generations
+    virtual void clear() = 0;
+
+    // Compute the next generation with the given rule and make it current
+    virtual void step(const CompiledLifeRule& rule) = 0;
+
+    // Make the previous generation identical to the current one
+    virtual void syncPreviousToCurrent() = 0;
+
+    // Force every tile to be recomputed on the next step (e.g. after a rule change)
+    virtual void markAllTilesDirty() = 0;
+
+    // Cell access (coordinates must be in range)
+    virtual bool getCell(int x, int y) const = 0;
+    virtual bool getPreviousCell(int x, int y) const = 0;
+    virtual void setCell(int x, int y, bool state) = 0;
+
+    // Word access (bit n of word k in row y is column k * 64 + n)
+    virtual Word getCurrentWord(int y, int wordIndex) const = 0;
+    virtual Word getPreviousWord(int y, int wordIndex) const = 0;
+
+    // Count the live cells in the current generation
+    virtual int countLiveCells() const = 0;
+
+    // Copy the current generation into state (getHeight() * getWordsPerRow() words, row by row)
+    virtual void storeCurrent(Word* state) const = 0;
+
+    // Make a stored generation current, keeping the old current generation as the previous one
+    virtual void advanceTo(const Word* state) = 0;
+
+    // Make the current generation XOR delta current (delta laid out like a stored generation),
+    // keeping the old current generation as the previous one
+    virtual void advanceByDelta(const Word* delta) = 0;
+
+    // Replace both generations with a stored one, as if every cell had been edited
+    virtual void load(const Word* state) = 0;
+
+    // Kill the cells set in mask (laid out like a stored generation) in the current generation,
+    // e.g. births into dying cells; their tiles are recomputed on the next step
+    virtual void removeCells(const Word* mask) = 0;
+
+    // Write the births, deaths and survivals of the last generation to events (which must have
+    // room for one event per cell), in row order. Returns the number of events written.
+    virtual int collectEvents(CellEvent* events) const = 0;
+};
+
+/**
+ * Grid engine backed by a pair of BitBoards.
+ * GridEngine<W, H> is specialised at compile time; GridEngine<0, 0> is sized at runtime.
+ *
+ * The engine remembers which tiles changed in the last generation, and the next step only
+ * recomputes tiles with a changed tile in their neighbourhood. Stable regions (still lifes,
+ * empty space) cost nothing.
+ */
+template <int Width, int Height>
+class GridEngine : public GridEngineBase
+{
+public:
+    using Board = BitBoard<Width, Height>;
+    using TileMask = typename Board::TileMask;
+
+    GridEngine() { markAllTilesDirty(); }
+
+    // Resize a runtime-sized engine (clears the grid)
+    void resize(int newWidth, int newHeight)
+    {
+        boards[0].resize(newWidth, newHeight);
+        boards[1].resize(newWidth, newHeight);
+        markAllTilesDirty();
+    }
+
+    int getWidth() const override { return current().width(); }
+    int getHeight() const override { return current().height(); }
+    int getWordsPerRow() const override { return current().wordsPerRow(); }
+
+    void clear() override
+    {
+        boards[0].clear();
+        boards[1].clear();
+        markAllTilesDirty();
+    }
+
+    void step(const CompiledLifeRule& rule) override
+    {
+        // Only tiles next to a change can change in this generation
+        TileMask tilesToUpdate;
+        current().expandTileMask(changedTiles, tilesToUpdate);
+
+        // Conway keeps its dedicated formula; other rules use the compiled one
+        if (rule.getRule().isConway())
+            stepBitBoard(current(), previous(), ConwayRule(), &tilesToUpdate, &changedTiles);
+        else
+            stepBitBoard(current(), previous(), rule, &tilesToUpdate, &changedTiles);
+
+        // The old current board becomes the previous generation without any copying
+        currentIndex ^= 1;
+    }
+
+    void syncPreviousToCurrent() override
+    {
+        previous() = current();
+        markAllTilesDirty();
+    }
+
+    void markAllTilesDirty() override { changedTiles.fill(~Word(0)); }
+
+    bool getCell(int x, int y) const override { return current().get(x, y); }
+    bool getPreviousCell(int x, int y) const override { return previous().get(x, y); }
+
+    void setCell(int x, int y, bool state) override
+    {
+        current().set(x, y, state);
+        previous().set(x, y, state);
+
+        // The edit does not show up as a change between the boards, so flag its tile
+        changedTiles[y / Board::TILE_ROWS] |= Word(1) << (x / Board::WORD_BITS);
+    }
+
+    Word getCurrentWord(int y, int wordIndex) const override { return current().row(y)[wordIndex]; }
+    Word getPreviousWord(int y, int wordIndex) const override { return previous().row(y)[wordIndex]; }
+
+    int countLiveCells() const override { return current().countLiveCells(); }
+
+    void storeCurrent(Word* state) const override
+    {
+        const Board& now = current();
+        const int words = now.wordsPerRow();
+
+        for (int y = 0; y < now.height(); ++y)
+            for (int k = 0; k < words; ++k)
+                *state++ = now.row(y)[k];
+    }
+
+    void advanceTo(const Word* state) override
+    {
+        Board& next = previous();
+        const int words = next.wordsPerRow();
+
+        for (int y = 0; y < next.height(); ++y)
+            for (int k = 0; k < words; ++k)
+                next.row(y)[k] = *state++;
+
+        currentIndex ^= 1;
+
+        // Any tile may differ from the previous generation
+        markAllTilesDirty();
+    }
+
+    void advanceByDelta(const Word* delta) override
+    {
+        const Board& now = current();
+        Board& next = previous();
+        const int words = next.wordsPerRow();
+
+        changedTiles.fill(0);
+
+        for (int y = 0; y < next.height(); ++y)
+        {
+            Word& tilesChanged = changedTiles[y / Board::TILE_ROWS];
+
+            for (int k = 0; k < words; ++k)
+            {
+                const Word change = *delta++;
+                next.row(y)[k] = now.row(y)[k] ^ change;
+
+                // The delta says exactly which tiles changed, so tracking stays precise
+                if (change != 0)
+                    tilesChanged |= Word(1) << k;
+            }
+        }
+
+        currentIndex ^= 1;
+    }
+
+    void load(const Word* state) override
+    {
+        Board& now = current();
+        const int words = now.wordsPerRow();
+
+        for (int y = 0; y < now.height(); ++y)
+            for (int k = 0; k < words; ++k)
+                now.row(y)[k] = *state++;
+
+        syncPreviousToCurrent();
+    }
+
+    void removeCells(const Word* mask) override
+    {
+        Board& now = current();
+        const int words = now.wordsPerRow();
+
+        for (int y = 0; y < now.height(); ++y)
+        {
+            for (int k = 0; k < words; ++k)
+            {
+                const Word removed = *mask++;
+                now.row(y)[k] &= ~removed;
+
+                if (removed != 0)
+                    changedTiles[y / Board::TILE_ROWS] |= Word(1) << k;
+            }
+        }
+    }
+
+    int collectEvents(CellEvent* events) const override
+    {
+        const Board& now = current();
+        const Board& before = previous();
+        const int height = now.height();
+        const int words = now.wordsPerRow();
+        int numEvents = 0;
+
+        for (int y = 0; y < height; ++y)
+        {
+            const Word tilesChanged = changedTiles[y / Board::TILE_ROWS];
+
+            for (int k = 0; k < words; ++k)
+            {
+                const Word alive = now.row(y)[k];
+
+                // Unchanged tiles can only hold survivors
+                if (((tilesChanged >> k) & 1) == 0)
+                {
+                    numEvents = appendEvents(events, numEvents, alive, k, y, CellEvent::Type::Survive);
+                    continue;
+                }
+
+                const Word wasAlive = before.row(y)[k];
+
+                numEvents = appendEvents(events, numEvents, alive & ~wasAlive, k, y, CellEvent::Type::Birth);
+                numEvents = appendEvents(events, numEvents, wasAlive & ~alive, k, y, CellEvent::Type::Death);
+                numEvents = appendEvents(events, numEvents, alive & wasAlive, k, y, CellEvent::Type::Survive);
+            }
+        }
+
+        return numEvents;
+    }
+
+private:
+    // Append one event per set bit of a word, lowest column first
+    static int appendEvents(CellEvent* events, int numEvents, Word mask, int wordIndex, int y, CellEvent::Type type)
+    {
+        while (mask != 0)
+        {
+            const int bit = BitOps::lowestSetBit(mask);
+            events[numEvents++] = { static_cast<uint16_t>(wordIndex * Board::WORD_BITS + bit), static_cast<uint16_t>(y), type };
+            mask &= mask - 1;
+        }
+
+        return numEvents;
+    }
+
+    Board& current() { return boards[currentIndex]; }
+    const Board& current() const { return boards[currentIndex]; }
+    Board& previous() { return boards[currentIndex ^ 1]; }
+    const Board& previous() const { return boards[currentIndex ^ 1]; }
+
+    // Current and previous generations, swapped by index after each update
+    Board boards[2];
+    int currentIndex = 0;
+
+    // Tiles that changed in the last generation or were edited since
+    TileMask changedTiles;
+};
+
+} // namespace GameOfLifeApp
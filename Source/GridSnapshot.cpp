@@ -0,0 +1,63 @@
+#include "GridSnapshot.h"
+
+namespace GameOfLifeApp {
+
+void GridSnapshotPublisher::publish(const Grid& grid)
+{
+    // Odd sequence: readers must not trust what they copy until the write is finished
+    const uint32_t count = sequence.load(std::memory_order_relaxed);
+    sequence.store(count + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    latest.generation = latestGeneration.load(std::memory_order_relaxed) + 1;
+    latest.width = grid.getWidth();
+    latest.height = grid.getHeight();
+    latest.wordsPerRow = grid.getWordsPerRow();
+    latest.hasDyingStates = grid.getRule().isGenerations();
+    grid.storeCells(latest.cells.data());
+
+    if (latest.hasDyingStates)
+        std::copy(grid.getDyingStates(), grid.getDyingStates() + latest.width * latest.height, latest.dyingStates.begin());
+
+    sequence.store(count + 2, std::memory_order_release);
+    latestGeneration.store(latest.generation, std::memory_order_release);
+}
+
+bool GridSnapshotPublisher::read(GridSnapshot& snapshot) const
+{
+    if (getGeneration() <= snapshot.generation)
+        return false;
+
+    for (;;)
+    {
+        const uint32_t count = sequence.load(std::memory_order_acquire);
+
+        if ((count & 1) == 0)
+        {
+            // Only the part of the arrays in use is copied. A torn read of the sizes is caught
+            // by the sequence check below; clamping keeps the copy in range meanwhile
+            const int width = juce::jlimit(1, ParameterManager::MAX_GRID_SIZE, latest.width);
+            const int height = juce::jlimit(1, ParameterManager::MAX_GRID_SIZE, latest.height);
+            const int wordsPerRow = juce::jlimit(1, BitBoard<0, 0>::MAX_WORDS_PER_ROW, latest.wordsPerRow);
+
+            snapshot.generation = latest.generation;
+            snapshot.width = width;
+            snapshot.height = height;
+            snapshot.wordsPerRow = wordsPerRow;
+            snapshot.hasDyingStates = latest.hasDyingStates;
+            std::copy(latest.cells.begin(), latest.cells.begin() + height * wordsPerRow, snapshot.cells.begin());
+
+            if (snapshot.hasDyingStates)
+                std::copy(latest.dyingStates.begin(), latest.dyingStates.begin() + width * height, snapshot.dyingStates.begin());
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            if (sequence.load(std::memory_order_relaxed) == count)
+                return true;
+        }
+
+        juce::Thread::yield();
+    }
+}
+
+} // namespace GameOfLifeApp
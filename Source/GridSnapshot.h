@@ -0,0 +1,77 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "ParameterManager.h"
+#include "Grid.h"
+
+namespace GameOfLifeApp {
+
+/**
+ * An immutable copy of the grid, for readers outside the audio thread (the UI)
+ */
+struct GridSnapshot
+{
+    using Word = Grid::Word;
+
+    // Words in one stored generation of the largest grid
+    static const int MAX_STATE_WORDS = ParameterManager::MAX_GRID_SIZE * BitBoard<0, 0>::MAX_WORDS_PER_ROW;
+
+    // Number of the snapshot; every generation and every edit gets a higher one (0 = nothing yet)
+    uint64_t generation = 0;
+
+    int width = ParameterManager::GRID_SIZE;
+    int height = ParameterManager::GRID_SIZE;
+    int wordsPerRow = 1;
+
+    // Dying states are only copied for Generations rules
+    bool hasDyingStates = false;
+
+    // Cells laid out like Grid::storeCells(), dying states like Grid::getDyingStates()
+    std::array<Word, MAX_STATE_WORDS> cells {};
+    std::array<uint8_t, ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE> dyingStates {};
+
+    // Cell access (coordinates must be in range)
+    bool getCellState(int x, int y) const
+    {
+        return ((cells[static_cast<size_t>(y * wordsPerRow + x / 64)] >> (x % 64)) & 1) != 0;
+    }
+
+    int getDyingState(int x, int y) const
+    {
+        return hasDyingStates ? dyingStates[static_cast<size_t>(y * width + x)] : 0;
+    }
+};
+
+/**
+ * Publishes grid snapshots from one writer thread to any number of readers without locking.
+ *
+ * The snapshot is guarded by a sequence lock: the count is odd while the writer is copying,
+ * and a reader retries if the count changed while it was reading. Readers keep their own copy
+ * and compare generation numbers, so polling never takes an update away from another reader.
+ */
+class GridSnapshotPublisher
+{
+public:
+    GridSnapshotPublisher() = default;
+
+    // Publish the current state of the grid as a new snapshot. Writer thread only.
+    void publish(const Grid& grid);
+
+    // Generation number of the latest snapshot (0 if nothing has been published)
+    uint64_t getGeneration() const { return latestGeneration.load(std::memory_order_acquire); }
+
+    // Copy the latest snapshot into snapshot if it is newer than the one already there.
+    // Returns true if the snapshot was updated.
+    bool read(GridSnapshot& snapshot) const;
+
+private:
+    GridSnapshot latest;
+    std::atomic<uint32_t> sequence { 0 };
+    std::atomic<uint64_t> latestGeneration { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GridSnapshotPublisher)
+};
+
+} // namespace GameOfLifeApp
@@ -0,0 +1,94 @@
+#include "LifeRule.h"
+
+namespace GameOfLifeApp {
+
+bool LifeRule::parse(const juce::String& ruleString, LifeRule& rule)
+{
+    juce::String text = ruleString.removeCharacters(" \t").toUpperCase();
+
+    juce::StringArray parts;
+    parts.addTokens(text, "/", "");
+
+    if (parts.size() != 2 && parts.size() != 3)
+        return false;
+
+    // Read a list of neighbour counts (0-8) into a bit mask
+    auto parseCounts = [](const juce::String& digits, uint16_t& mask)
+    {
+        mask = 0;
+        for (int i = 0; i < digits.length(); ++i)
+        {
+            auto c = digits[i];
+            if (c < '0' || c > '8')
+                return false;
+            mask |= static_cast<uint16_t>(1 << (c - '0'));
+        }
+        return true;
+    };
+
+    LifeRule parsed;
+    bool valid = false;
+
+    if (parts[0].startsWithChar('B') && parts[1].startsWithChar('S'))
+    {
+        // B.../S...
+        valid = parseCounts(parts[0].substring(1), parsed.birth)
+             && parseCounts(parts[1].substring(1), parsed.survive);
+    }
+    else if (parts[0].startsWithChar('S') && parts[1].startsWithChar('B'))
+    {
+        // S.../B...
+        valid = parseCounts(parts[0].substring(1), parsed.survive)
+             && parseCounts(parts[1].substring(1), parsed.birth);
+    }
+    else
+    {
+        // Legacy survive/birth form, e.g. "23/3"
+        valid = parseCounts(parts[0], parsed.survive)
+             && parseCounts(parts[1], parsed.birth);
+    }
+
+    // Number of states of a Generations rule, "C4" or just "4"
+    if (valid && parts.size() == 3)
+    {
+        juce::String count = parts[2].startsWithChar('C') ? parts[2].substring(1) : parts[2];
+
+        for (int i = 0; i < count.length(); ++i)
+            if (count[i] < '0' || count[i] > '9')
+                valid = false;
+
+        const int states = count.getIntValue();
+
+        if (count.isEmpty() || count.length() > 3 || states < 2 || states > MAX_STATES)
+            valid = false;
+        else
+            parsed.states = static_cast<uint8_t>(states);
+    }
+
+    if (valid)
+        rule = parsed;
+
+    return valid;
+}
+
+juce::String LifeRule::toString() const
+{
+    juce::String result = "B";
+
+    for (int n = 0; n <= 8; ++n)
+        if ((birth >> n) & 1)
+            result << n;
+
+    result << "/S";
+
+    for (int n = 0; n <= 8; ++n)
+        if ((survive >> n) & 1)
+            result << n;
+
+    if (isGenerations())
+        result << "/C" << static_cast<int>(states);
+
+    return result;
+}
+
+} // namespace GameOfLifeApp
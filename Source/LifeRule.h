@@ -0,0 +1,143 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include "BitBoard.h"
+
+namespace GameOfLifeApp {
+
+/**
+ * An outer-totalistic (Life-like) rule in B/S notation, e.g. "B3/S23" for Conway's Life.
+ * Bit n of birth / survive is set when a cell with n live neighbours is born / survives.
+ *
+ * A rule with more than two states is a Generations rule ("B2/S/C3" is Brian's Brain): a live
+ * cell that does not survive spends states - 2 generations dying, during which it neither
+ * counts as a neighbour nor can be born again.
+ */
+struct LifeRule
+{
+    // Largest number of states of a Generations rule
+    static const int MAX_STATES = 255;
+
+    uint16_t birth = 0;
+    uint16_t survive = 0;
+    uint8_t states = 2;
+
+    // Conway's Game of Life (B3/S23)
+    static LifeRule conway() { return { 1 << 3, (1 << 2) | (1 << 3), 2 }; }
+
+    // Parse a rulestring ("B36/S23", "b3/s23", "S23/B3", the legacy survive/birth form "23/3",
+    // or a Generations rule such as "B2/S345/C4" or "345/2/4")
+    // Returns false and leaves the rule unchanged if the string is not a valid rule
+    static bool parse(const juce::String& ruleString, LifeRule& rule);
+
+    // Format the rule as a "B.../S..." rulestring ("B.../S.../C..." for a Generations rule)
+    juce::String toString() const;
+
+    bool isConway() const { return *this == conway(); }
+
+    // Check if cells go through dying states
+    bool isGenerations() const { return states > 2; }
+
+    // Generations a cell spends dying after it stops surviving
+    int getDyingGenerations() const { return states - 2; }
+
+    // Pack the rule into a single integer (for storing in an atomic), and back again
+    uint32_t pack() const { return (static_cast<uint32_t>(states) << 18) | (static_cast<uint32_t>(survive) << 9) | birth; }
+    static LifeRule unpack(uint32_t packed)
+    {
+        return { static_cast<uint16_t>(packed & 0x1ff),
+                 static_cast<uint16_t>((packed >> 9) & 0x1ff),
+                 static_cast<uint8_t>(juce::jmax(2u, (packed >> 18) & 0xff)) };
+    }
+
+    bool operator==(const LifeRule& other) const { return birth == other.birth && survive == other.survive && states == other.states; }
+    bool operator!=(const LifeRule& other) const { return !(*this == other); }
+};
+
+/**
+ * Named rule presets offered by the rule parameters
+ */
+struct LifeRulePreset
+{
+    const char* name;
+    const char* ruleString;
+};
+
+static const LifeRulePreset LIFE_RULE_PRESETS[] =
+{
+    { "Conway",             "B3/S23" },
+    { "HighLife",           "B36/S23" },
+    { "Seeds",              "B2/S" },
+    { "Day & Night",        "B3678/S34678" },
+    { "Morley",             "B368/S245" },
+    { "Life without Death", "B3/S012345678" },
+    { "2x2",                "B36/S125" },
+    { "Maze",               "B3/S12345" },
+    { "Replicator",         "B1357/S1357" },
+    { "Diamoeba",           "B35678/S5678" },
+    { "Anneal",             "B4678/S35678" },
+    { "Brian's Brain",      "B2/S/C3" },
+    { "Star Wars",          "B2/S345/C4" },
+    { "Frogs",              "B34/S12/C3" }
+};
+
+static const int NUM_LIFE_RULE_PRESETS = static_cast<int>(sizeof(LIFE_RULE_PRESETS) / sizeof(LIFE_RULE_PRESETS[0]));
+
+/**
+ * A LifeRule compiled into a lookup table of word masks.
+ * The next state for each neighbour count n is birth[n] ^ (alive & (birth[n] ^ survive[n])),
+ * and the count planes select the entry through a fixed multiplexer tree, so a word of
+ * 64 cells is evaluated with the same sequence of bit operations whatever the rule.
+ */
+class CompiledLifeRule
+{
+public:
+    CompiledLifeRule() : CompiledLifeRule(LifeRule::conway()) {}
+
+    explicit CompiledLifeRule(const LifeRule& rule) : source(rule)
+    {
+        for (int n = 0; n <= 8; ++n)
+        {
+            const uint64_t birth = ((rule.birth >> n) & 1) ? ~uint64_t(0) : 0;
+            const uint64_t survive = ((rule.survive >> n) & 1) ? ~uint64_t(0) : 0;
+
+            birthMasks[n] = birth;
+            differenceMasks[n] = birth ^ survive;
+        }
+    }
+
+    const LifeRule& getRule() const { return source; }
+
+    // Next state of 64 cells from their neighbour count and current state
+    uint64_t operator()(const NeighbourCount& count, uint64_t alive) const
+    {
+        // Next state of each cell for every possible neighbour count
+        uint64_t next[9];
+        for (int n = 0; n <= 8; ++n)
+            next[n] = birthMasks[n] ^ (alive & differenceMasks[n]);
+
+        // Select by count, one plane at a time (a count of 8 is the only one with s3 set)
+        const uint64_t n01 = select(count.s0, next[1], next[0]);
+        const uint64_t n23 = select(count.s0, next[3], next[2]);
+        const uint64_t n45 = select(count.s0, next[5], next[4]);
+        const uint64_t n67 = select(count.s0, next[7], next[6]);
+        const uint64_t n03 = select(count.s1, n23, n01);
+        const uint64_t n47 = select(count.s1, n67, n45);
+        const uint64_t n07 = select(count.s2, n47, n03);
+        return select(count.s3, next[8], n07);
+    }
+
+private:
+    // Bitwise multiplexer: bits of ifSet where condition is set, bits of ifClear elsewhere
+    static uint64_t select(uint64_t condition, uint64_t ifSet, uint64_t ifClear)
+    {
+        return ifClear ^ ((ifSet ^ ifClear) & condition);
+    }
+
+    LifeRule source;
+    uint64_t birthMasks[9] = {};
+    uint64_t differenceMasks[9] = {};
+};
+
+} // namespace GameOfLifeApp
@@ -0,0 +1,95 @@
+#include "MidiClockSync.h"
+
+void MidiClockSync::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+    running = true;
+    locked = false;
+    tickCount = -1;
+    period = 0.0;
+    hasLastTick = false;
+}
+
+void MidiClockSync::handleTick(int64_t samplePosition)
+{
+    const double position = static_cast<double>(samplePosition);
+    const double minPeriod = sampleRate * 60.0 / (MAX_TEMPO * TICKS_PER_QUARTER_NOTE);
+    const double maxPeriod = sampleRate * 60.0 / (MIN_TEMPO * TICKS_PER_QUARTER_NOTE);
+
+    if (running)
+        ++tickCount;
+
+    // The clock stopped for a while (or the processor's clock was restarted): measure again
+    if (hasLastTick && (position <= lastTickPosition
+                        || (period > 0.0 && position - lastTickPosition > MAX_MISSING_TICKS * period)))
+    {
+        locked = false;
+        period = 0.0;
+        hasLastTick = false;
+    }
+
+    if (! locked)
+    {
+        // The first period is measured from two ticks (ignored if it is out of range)
+        if (period <= 0.0 && hasLastTick)
+        {
+            const double measured = position - lastTickPosition;
+            period = (measured >= minPeriod && measured <= maxPeriod) ? measured : 0.0;
+        }
+
+        if (period > 0.0)
+            relock(position);
+    }
+    else
+    {
+        // Correct the phase by part of the error, and the period by a smaller part
+        const double error = position - predictedPosition;
+        tickPosition = predictedPosition + PHASE_GAIN * error;
+        period = juce::jlimit(minPeriod, maxPeriod, period + PERIOD_GAIN * error);
+
+        predictedPosition = tickPosition + period;
+    }
+
+    lastTickPosition = position;
+    hasLastTick = true;
+}
+
+void MidiClockSync::relock(double position)
+{
+    tickPosition = position;
+    predictedPosition = position + period;
+    locked = true;
+}
+
+void MidiClockSync::handleStart()
+{
+    // The next tick is the first of the song
+    running = true;
+    locked = false;
+    tickCount = -1;
+}
+
+void MidiClockSync::handleContinue()
+{
+    running = true;
+    locked = false;
+}
+
+void MidiClockSync::handleStop()
+{
+    running = false;
+}
+
+void MidiClockSync::handleSongPosition(int sixteenthNotes)
+{
+    // A sixteenth note is 6 ticks; the next tick is the one at the new position
+    tickCount = static_cast<int64_t>(sixteenthNotes) * (TICKS_PER_QUARTER_NOTE / 4) - 1;
+}
+
+double MidiClockSync::getTempo() const
+{
+    if (period <= 0.0)
+        return 0.0;
+
+    return sampleRate * 60.0 / (period * TICKS_PER_QUARTER_NOTE);
+}
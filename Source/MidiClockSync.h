@@ -0,0 +1,82 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+
+/**
+ * Follows an external MIDI clock (24 ticks per quarter note).
+ *
+ * Clock messages arrive with the jitter of the sender and the MIDI driver, so the tick positions
+ * are smoothed by a second-order phase-locked loop: each tick is compared with the position the
+ * loop predicted for it, and the error nudges both the phase and the tick period. The smoothed
+ * positions and the tempo derived from the period are steady enough to place generations on.
+ *
+ * Start, Continue and Stop control the transport; Start and Continue drop the phase so the loop
+ * relocks on the next tick. Until the first Stop the clock counts as running, so a sender that
+ * only sends ticks still drives the grid.
+ */
+class MidiClockSync
+{
+public:
+    static const int TICKS_PER_QUARTER_NOTE = 24;
+
+    MidiClockSync() = default;
+
+    // Forget the clock and its tempo
+    void prepare(double newSampleRate);
+
+    // Feed the clock and transport messages, with their positions on the processor's sample clock
+    void handleTick(int64_t samplePosition);
+    void handleStart();
+    void handleContinue();
+    void handleStop();
+    void handleSongPosition(int sixteenthNotes);
+
+    // Whether the sender's transport is running
+    bool isRunning() const { return running; }
+
+    // Whether the loop has a phase and period to place ticks with
+    bool isLocked() const { return locked; }
+
+    // Ticks since the song start, counting the latest tick as 0 right after Start
+    int64_t getTickCount() const { return tickCount; }
+
+    // Smoothed position of the latest tick on the sample clock
+    double getTickPosition() const { return tickPosition; }
+
+    // Tempo of the clock in BPM, or 0 if it is not known yet
+    double getTempo() const;
+
+private:
+    // Loop gains for the phase and the period; about a 3% bandwidth per tick, so a few
+    // quarter notes to settle on a new tempo while jitter of single ticks is filtered out
+    static constexpr double PHASE_GAIN = 0.27;
+    static constexpr double PERIOD_GAIN = 0.036;
+
+    // Clock rates the loop accepts (in BPM); a gap longer than MAX_MISSING_TICKS means the
+    // clock went away, and the period is measured afresh
+    static constexpr double MIN_TEMPO = 20.0;
+    static constexpr double MAX_TEMPO = 400.0;
+    static constexpr double MAX_MISSING_TICKS = 4.0;
+
+    // Restart the loop from a tick at position, keeping the period if it is still known
+    void relock(double position);
+
+    double sampleRate = 44100.0;
+
+    bool running = true;
+    bool locked = false;
+    int64_t tickCount = -1;
+
+    // Loop state: smoothed position of the latest tick, prediction for the next one, and the
+    // estimated samples per tick (0 = unknown)
+    double tickPosition = 0.0;
+    double predictedPosition = 0.0;
+    double period = 0.0;
+
+    // Raw position of the previous tick, for measuring the first period
+    double lastTickPosition = 0.0;
+    bool hasLastTick = false;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiClockSync)
+};
@@ -0,0 +1,596 @@
+#include "MixKernel.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#if defined(__AVX2__)
+ #include <immintrin.h>
+ #define SYNTHOFLIFE_MIX_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #include <emmintrin.h>
+ #define SYNTHOFLIFE_MIX_SSE2 1
+#endif
+
+namespace MixKernel
+{
+namespace
+{
+    // Sinc tables: phases per frame, half the taps of the unison band, bands of playback rate per
+    // octave and octaves covered (the last band is also used for anything faster), passband as a
+    // fraction of Nyquist
+    constexpr int SINC_PHASES = 128;
+    constexpr int SINC_HALF_WIDTH = 8;
+    constexpr int SINC_BANDS_PER_OCTAVE = 6;
+    constexpr int NUM_SINC_OCTAVES = 3;
+    constexpr int NUM_SINC_BANDS = NUM_SINC_OCTAVES * SINC_BANDS_PER_OCTAVE + 1;
+    constexpr int MAX_SINC_HALF_WIDTH = SINC_HALF_WIDTH << NUM_SINC_OCTAVES;
+    constexpr double SINC_CUTOFF = 0.92;
+    constexpr double KAISER_BETA = 8.0;
+
+    // Coefficients of one band: SINC_PHASES + 1 rows of 2 * halfWidth taps. Row r holds the
+    // taps for frames -(halfWidth - 1) to halfWidth around a position r / SINC_PHASES past a frame.
+    struct SincTable
+    {
+        float maxRate = 0.0f;   // fastest playback rate the band's cutoff keeps free of aliasing
+        int halfWidth = 0;
+        std::vector<float> coefficients;
+
+        const float* getRow(int phase) const { return coefficients.data() + static_cast<size_t>(phase * 2 * halfWidth); }
+    };
+
+    // Zeroth-order modified Bessel function of the first kind, for the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1.0;
+        double term = 1.0;
+
+        for (int k = 1; k < 50 && term > sum * 1.0e-12; ++k)
+        {
+            const double half = x / (2.0 * k);
+            term *= half * half;
+            sum += term;
+        }
+
+        return sum;
+    }
+
+    SincTable buildSincTable(int band)
+    {
+        SincTable table;
+        const double maxRate = std::pow(2.0, band / static_cast<double>(SINC_BANDS_PER_OCTAVE));
+        table.maxRate = static_cast<float>(maxRate);
+
+        // The kernel stretches with the band, rounded up to whole runs of 16 taps for dotProduct()
+        table.halfWidth = juce::jmin(MAX_SINC_HALF_WIDTH, 8 * static_cast<int>(std::ceil(SINC_HALF_WIDTH * maxRate / 8.0)));
+
+        const int numTaps = 2 * table.halfWidth;
+        const double cutoff = SINC_CUTOFF / maxRate;
+        const double windowNorm = besselI0(KAISER_BETA);
+
+        table.coefficients.resize(static_cast<size_t>((SINC_PHASES + 1) * numTaps));
+
+        for (int phase = 0; phase <= SINC_PHASES; ++phase)
+        {
+            float* row = table.coefficients.data() + static_cast<size_t>(phase * numTaps);
+            double sum = 0.0;
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                const double x = (tap - (table.halfWidth - 1)) - phase / static_cast<double>(SINC_PHASES);
+                const double u = x / table.halfWidth;
+
+                const double sinc = x == 0.0 ? 1.0 : std::sin(juce::MathConstants<double>::pi * cutoff * x)
+                                                     / (juce::MathConstants<double>::pi * cutoff * x);
+                const double window = std::abs(u) < 1.0 ? besselI0(KAISER_BETA * std::sqrt(1.0 - u * u)) / windowNorm : 0.0;
+
+                const double value = cutoff * sinc * window;
+                row[tap] = static_cast<float>(value);
+                sum += value;
+            }
+
+            // Unity gain at DC for every phase
+            for (int tap = 0; tap < numTaps; ++tap)
+                row[tap] = static_cast<float>(row[tap] / sum);
+        }
+
+        return table;
+    }
+
+    const std::array<SincTable, NUM_SINC_BANDS>& getSincTables()
+    {
+        static const auto tables = []
+        {
+            std::array<SincTable, NUM_SINC_BANDS> bands;
+            for (int band = 0; band < NUM_SINC_BANDS; ++band)
+                bands[static_cast<size_t>(band)] = buildSincTable(band);
+            return bands;
+        }();
+
+        return tables;
+    }
+
+    // The band with the highest cutoff that is still low enough for the playback rate
+    const SincTable& getSincTable(float rate)
+    {
+        const auto& tables = getSincTables();
+
+        int band = 0;
+        while (band < NUM_SINC_BANDS - 1 && rate > tables[static_cast<size_t>(band)].maxRate)
+            ++band;
+
+        return tables[static_cast<size_t>(band)];
+    }
+
+    // The source position of output sample k is base + (frac + k * rate): the whole part of the
+    // start position is kept apart so the float part stays small and precise
+    struct Cursor
+    {
+        int base;
+        float frac;
+        float rate;
+
+        float offsetAt(int k) const { return frac + static_cast<float>(k) * rate; }
+    };
+
+    Cursor makeCursor(double position, float rate)
+    {
+        const double base = std::floor(position);
+        return { static_cast<int>(base), static_cast<float>(position - base), rate };
+    }
+
+    // Output samples, from the start, whose source frame is before limit
+    int countFramesBefore(const Cursor& cursor, int limit, int numSamples)
+    {
+        const int available = limit - cursor.base;
+        if (available <= 0)
+            return 0;
+
+        if (cursor.rate <= 0.0f)
+            return numSamples;
+
+        // Estimate, then correct for rounding against the exact per-sample positions
+        const double estimate = std::ceil((available - static_cast<double>(cursor.frac)) / cursor.rate);
+        int count = static_cast<int>(juce::jlimit(0.0, static_cast<double>(numSamples), estimate));
+
+        while (count > 0 && static_cast<int>(cursor.offsetAt(count - 1)) >= available)
+            --count;
+
+        while (count < numSamples && static_cast<int>(cursor.offsetAt(count)) < available)
+            ++count;
+
+        return count;
+    }
+
+    // A source frame, or silence outside the source
+    inline float frameAt(const float* data, int length, int index)
+    {
+        return index >= 0 && index < length ? data[index] : 0.0f;
+    }
+
+    inline float linear(float y0, float y1, float t)
+    {
+        return y0 + t * (y1 - y0);
+    }
+
+    // Catmull-Rom spline through four frames, between y1 and y2
+    inline float cubic(float y0, float y1, float y2, float y3, float t)
+    {
+        const float c1 = 0.5f * (y2 - y0);
+        const float c2 = y0 - 2.5f * y1 + 2.0f * y2 - 0.5f * y3;
+        const float c3 = 0.5f * (y3 - y0) + 1.5f * (y1 - y2);
+        return ((c3 * t + c2) * t + c1) * t + y1;
+    }
+
+    // Sum of the products of two runs of floats
+    inline float dotProductScalar(const float* a, const float* b, int length)
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < length; ++i)
+            sum += a[i] * b[i];
+        return sum;
+    }
+
+    // Vectorised dotProductScalar() (the length is a multiple of 16)
+    inline float dotProduct(const float* a, const float* b, int length)
+    {
+       #if SYNTHOFLIFE_MIX_AVX2
+        __m256 sum0 = _mm256_setzero_ps();
+        __m256 sum1 = _mm256_setzero_ps();
+
+        for (int i = 0; i < length; i += 16)
+        {
+            sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+            sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+        }
+
+        const __m256 sum = _mm256_add_ps(sum0, sum1);
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        return _mm_cvtss_f32(half);
+       #elif SYNTHOFLIFE_MIX_SSE2
+        __m128 sum0 = _mm_setzero_ps();
+        __m128 sum1 = _mm_setzero_ps();
+
+        for (int i = 0; i < length; i += 8)
+        {
+            sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+            sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        }
+
+        __m128 sum = _mm_add_ps(sum0, sum1);
+        sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+        sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+        return _mm_cvtss_f32(sum);
+       #else
+        return dotProductScalar(a, b, length);
+       #endif
+    }
+
+    // Scalar loop over output samples [begin, end), reading silence outside the source
+    void mixRange(const Source& source, const Cursor& cursor, float leftGain, float rightGain,
+                  const Output& output, Interpolation interpolation, int begin, int end)
+    {
+        const bool stereoSource = source.right != source.left;
+
+        for (int k = begin; k < end; ++k)
+        {
+            const float offset = cursor.offsetAt(k);
+            const int whole = static_cast<int>(offset);
+            const float t = offset - static_cast<float>(whole);
+            const int index = cursor.base + whole;
+
+            float left;
+            float right;
+
+            if (interpolation == Interpolation::Cubic)
+            {
+                left = cubic(frameAt(source.left, source.length, index - 1), frameAt(source.left, source.length, index),
+                             frameAt(source.left, source.length, index + 1), frameAt(source.left, source.length, index + 2), t);
+                right = ! stereoSource ? left
+                                       : cubic(frameAt(source.right, source.length, index - 1), frameAt(source.right, source.length, index),
+                                               frameAt(source.right, source.length, index + 1), frameAt(source.right, source.length, index + 2), t);
+            }
+            else
+            {
+                left = linear(frameAt(source.left, source.length, index), frameAt(source.left, source.length, index + 1), t);
+                right = ! stereoSource ? left
+                                       : linear(frameAt(source.right, source.length, index), frameAt(source.right, source.length, index + 1), t);
+            }
+
+            if (output.envelope != nullptr)
+            {
+                left *= output.envelope[k];
+                right *= output.envelope[k];
+            }
+
+            output.left[k] += left * leftGain;
+
+            if (output.right != nullptr)
+                output.right[k] += right * rightGain;
+        }
+    }
+
+    // Windowed sinc over output samples [0, end); useVector picks the vectorised dot product
+    void mixSinc(const Source& source, const Cursor& cursor, float leftGain, float rightGain,
+                 const Output& output, int end, bool useVector)
+    {
+        const bool stereoSource = source.right != source.left;
+        const SincTable& table = getSincTable(cursor.rate);
+        const int numTaps = 2 * table.halfWidth;
+
+        // Frames around the start and end of the source, padded with silence
+        std::array<float, 2 * MAX_SINC_HALF_WIDTH> paddedLeft;
+        std::array<float, 2 * MAX_SINC_HALF_WIDTH> paddedRight;
+
+        for (int k = 0; k < end; ++k)
+        {
+            const float offset = cursor.offsetAt(k);
+            const int whole = static_cast<int>(offset);
+            const float phasePosition = (offset - static_cast<float>(whole)) * SINC_PHASES;
+            const int phase = juce::jmin(static_cast<int>(phasePosition), SINC_PHASES - 1);
+            const float phaseFraction = phasePosition - static_cast<float>(phase);
+            const int first = cursor.base + whole - (table.halfWidth - 1);
+
+            const float* left = source.left + first;
+            const float* right = source.right + first;
+
+            if (first < 0 || first + numTaps > source.length)
+            {
+                for (int tap = 0; tap < numTaps; ++tap)
+                {
+                    paddedLeft[static_cast<size_t>(tap)] = frameAt(source.left, source.length, first + tap);
+                    paddedRight[static_cast<size_t>(tap)] = frameAt(source.right, source.length, first + tap);
+                }
+
+                left = paddedLeft.data();
+                right = paddedRight.data();
+            }
+
+            // Interpolate between the two nearest phases of the table
+            const float* row0 = table.getRow(phase);
+            const float* row1 = table.getRow(phase + 1);
+
+            const float left0 = useVector ? dotProduct(left, row0, numTaps) : dotProductScalar(left, row0, numTaps);
+            const float left1 = useVector ? dotProduct(left, row1, numTaps) : dotProductScalar(left, row1, numTaps);
+            float leftSample = linear(left0, left1, phaseFraction);
+
+            float rightSample = leftSample;
+            if (stereoSource)
+            {
+                const float right0 = useVector ? dotProduct(right, row0, numTaps) : dotProductScalar(right, row0, numTaps);
+                const float right1 = useVector ? dotProduct(right, row1, numTaps) : dotProductScalar(right, row1, numTaps);
+                rightSample = linear(right0, right1, phaseFraction);
+            }
+
+            if (output.envelope != nullptr)
+            {
+                leftSample *= output.envelope[k];
+                rightSample *= output.envelope[k];
+            }
+
+            output.left[k] += leftSample * leftGain;
+
+            if (output.right != nullptr)
+                output.right[k] += rightSample * rightGain;
+        }
+    }
+
+   #if SYNTHOFLIFE_MIX_AVX2
+    constexpr int VECTOR_SIZE = 8;
+
+    // Eight output samples at a time over [begin, end); every frame the interpolation reads
+    // must be inside the source
+    int mixVector(const Source& source, const Cursor& cursor, float leftGain, float rightGain,
+                  const Output& output, Interpolation interpolation, int begin, int end)
+    {
+        const bool stereoSource = source.right != source.left;
+        const bool useCubic = interpolation == Interpolation::Cubic;
+        const float* left = source.left + cursor.base;
+        const float* right = source.right + cursor.base;
+
+        const __m256 lanes = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+        const __m256 frac = _mm256_set1_ps(cursor.frac);
+        const __m256 rate = _mm256_set1_ps(cursor.rate);
+        const __m256 gainLeft = _mm256_set1_ps(leftGain);
+        const __m256 gainRight = _mm256_set1_ps(rightGain);
+        const __m256i one = _mm256_set1_epi32(1);
+        const __m256 half = _mm256_set1_ps(0.5f);
+        const __m256 oneAndHalf = _mm256_set1_ps(1.5f);
+        const __m256 two = _mm256_set1_ps(2.0f);
+        const __m256 twoAndHalf = _mm256_set1_ps(2.5f);
+
+        // Catmull-Rom, with the same operation order as cubic()
+        auto interpolate = [&](const float* data, __m256i whole, __m256i next, __m256 t)
+        {
+            const __m256 y1 = _mm256_i32gather_ps(data, whole, 4);
+            const __m256 y2 = _mm256_i32gather_ps(data, next, 4);
+
+            if (! useCubic)
+                return _mm256_add_ps(y1, _mm256_mul_ps(t, _mm256_sub_ps(y2, y1)));
+
+            const __m256 y0 = _mm256_i32gather_ps(data, _mm256_sub_epi32(whole, one), 4);
+            const __m256 y3 = _mm256_i32gather_ps(data, _mm256_add_epi32(next, one), 4);
+
+            const __m256 c1 = _mm256_mul_ps(half, _mm256_sub_ps(y2, y0));
+            const __m256 c2 = _mm256_sub_ps(_mm256_add_ps(_mm256_sub_ps(y0, _mm256_mul_ps(twoAndHalf, y1)), _mm256_mul_ps(two, y2)),
+                                            _mm256_mul_ps(half, y3));
+            const __m256 c3 = _mm256_add_ps(_mm256_mul_ps(half, _mm256_sub_ps(y3, y0)), _mm256_mul_ps(oneAndHalf, _mm256_sub_ps(y1, y2)));
+            return _mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(c3, t), c2), t), c1), t), y1);
+        };
+
+        int k = begin;
+        for (; k + VECTOR_SIZE <= end; k += VECTOR_SIZE)
+        {
+            const __m256 offset = _mm256_add_ps(frac, _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(k)), lanes), rate));
+            const __m256i whole = _mm256_cvttps_epi32(offset);
+            const __m256i next = _mm256_add_epi32(whole, one);
+            const __m256 t = _mm256_sub_ps(offset, _mm256_cvtepi32_ps(whole));
+
+            __m256 leftSample = interpolate(left, whole, next, t);
+            __m256 rightSample = stereoSource ? interpolate(right, whole, next, t) : leftSample;
+
+            if (output.envelope != nullptr)
+            {
+                const __m256 level = _mm256_loadu_ps(output.envelope + k);
+                leftSample = _mm256_mul_ps(leftSample, level);
+                rightSample = _mm256_mul_ps(rightSample, level);
+            }
+
+            float* outLeft = output.left + k;
+            _mm256_storeu_ps(outLeft, _mm256_add_ps(_mm256_loadu_ps(outLeft), _mm256_mul_ps(leftSample, gainLeft)));
+
+            if (output.right != nullptr)
+            {
+                float* outRight = output.right + k;
+                _mm256_storeu_ps(outRight, _mm256_add_ps(_mm256_loadu_ps(outRight), _mm256_mul_ps(rightSample, gainRight)));
+            }
+        }
+
+        return k;
+    }
+   #elif SYNTHOFLIFE_MIX_SSE2
+    constexpr int VECTOR_SIZE = 4;
+
+    // Loads the frames at four indices (SSE2 has no gather)
+    inline __m128 gather(const float* data, const int32_t* indices)
+    {
+        return _mm_setr_ps(data[indices[0]], data[indices[1]], data[indices[2]], data[indices[3]]);
+    }
+
+    // Four output samples at a time over [begin, end); every frame the interpolation reads
+    // must be inside the source
+    int mixVector(const Source& source, const Cursor& cursor, float leftGain, float rightGain,
+                  const Output& output, Interpolation interpolation, int begin, int end)
+    {
+        const bool stereoSource = source.right != source.left;
+        const bool useCubic = interpolation == Interpolation::Cubic;
+        const float* left = source.left + cursor.base;
+        const float* right = source.right + cursor.base;
+
+        const __m128 lanes = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+        const __m128 frac = _mm_set1_ps(cursor.frac);
+        const __m128 rate = _mm_set1_ps(cursor.rate);
+        const __m128 gainLeft = _mm_set1_ps(leftGain);
+        const __m128 gainRight = _mm_set1_ps(rightGain);
+        const __m128 half = _mm_set1_ps(0.5f);
+        const __m128 oneAndHalf = _mm_set1_ps(1.5f);
+        const __m128 two = _mm_set1_ps(2.0f);
+        const __m128 twoAndHalf = _mm_set1_ps(2.5f);
+
+        alignas(16) int32_t indices[4];
+
+        // Catmull-Rom, with the same operation order as cubic()
+        auto interpolate = [&](const float* data, __m128 t)
+        {
+            const __m128 y1 = gather(data, indices);
+            const __m128 y2 = gather(data + 1, indices);
+
+            if (! useCubic)
+                return _mm_add_ps(y1, _mm_mul_ps(t, _mm_sub_ps(y2, y1)));
+
+            const __m128 y0 = gather(data - 1, indices);
+            const __m128 y3 = gather(data + 2, indices);
+
+            const __m128 c1 = _mm_mul_ps(half, _mm_sub_ps(y2, y0));
+            const __m128 c2 = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(y0, _mm_mul_ps(twoAndHalf, y1)), _mm_mul_ps(two, y2)),
+                                         _mm_mul_ps(half, y3));
+            const __m128 c3 = _mm_add_ps(_mm_mul_ps(half, _mm_sub_ps(y3, y0)), _mm_mul_ps(oneAndHalf, _mm_sub_ps(y1, y2)));
+            return _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_mul_ps(c3, t), c2), t), c1), t), y1);
+        };
+
+        int k = begin;
+        for (; k + VECTOR_SIZE <= end; k += VECTOR_SIZE)
+        {
+            const __m128 offset = _mm_add_ps(frac, _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(k)), lanes), rate));
+            const __m128i whole = _mm_cvttps_epi32(offset);
+            const __m128 t = _mm_sub_ps(offset, _mm_cvtepi32_ps(whole));
+            _mm_store_si128(reinterpret_cast<__m128i*>(indices), whole);
+
+            __m128 leftSample = interpolate(left, t);
+            __m128 rightSample = stereoSource ? interpolate(right, t) : leftSample;
+
+            if (output.envelope != nullptr)
+            {
+                const __m128 level = _mm_loadu_ps(output.envelope + k);
+                leftSample = _mm_mul_ps(leftSample, level);
+                rightSample = _mm_mul_ps(rightSample, level);
+            }
+
+            float* outLeft = output.left + k;
+            _mm_storeu_ps(outLeft, _mm_add_ps(_mm_loadu_ps(outLeft), _mm_mul_ps(leftSample, gainLeft)));
+
+            if (output.right != nullptr)
+            {
+                float* outRight = output.right + k;
+                _mm_storeu_ps(outRight, _mm_add_ps(_mm_loadu_ps(outRight), _mm_mul_ps(rightSample, gainRight)));
+            }
+        }
+
+        return k;
+    }
+   #endif
+
+    bool isValid(const Source& source, const Output& output, double position)
+    {
+        return source.left != nullptr && source.right != nullptr && source.length > 0
+            && output.left != nullptr && output.numSamples > 0 && position >= 0.0;
+    }
+}
+
+int mix(const Source& source, double position, float rate, float leftGain, float rightGain, const Output& output,
+        Interpolation interpolation)
+{
+    if (! isValid(source, output, position))
+        return 0;
+
+    const Cursor cursor = makeCursor(position, rate);
+    const int numReading = countFramesBefore(cursor, source.length, output.numSamples);
+
+    if (interpolation == Interpolation::Sinc)
+    {
+        mixSinc(source, cursor, leftGain, rightGain, output, numReading, true);
+        return numReading;
+    }
+
+   #if SYNTHOFLIFE_MIX_AVX2 || SYNTHOFLIFE_MIX_SSE2
+    // The vector loop takes the samples whose frames (one before and two after, for cubic) are
+    // all inside the source; the few at either end are done one by one
+    const bool useCubic = interpolation == Interpolation::Cubic;
+    const int vectorBegin = useCubic ? countFramesBefore(cursor, 1, numReading) : 0;
+    const int vectorEnd = juce::jmax(vectorBegin, countFramesBefore(cursor, source.length - (useCubic ? 2 : 1), numReading));
+
+    mixRange(source, cursor, leftGain, rightGain, output, interpolation, 0, vectorBegin);
+    const int vectorDone = mixVector(source, cursor, leftGain, rightGain, output, interpolation, vectorBegin, vectorEnd);
+    mixRange(source, cursor, leftGain, rightGain, output, interpolation, vectorDone, numReading);
+   #else
+    mixRange(source, cursor, leftGain, rightGain, output, interpolation, 0, numReading);
+   #endif
+
+    return numReading;
+}
+
+int mixScalar(const Source& source, double position, float rate, float leftGain, float rightGain, const Output& output,
+              Interpolation interpolation)
+{
+    if (! isValid(source, output, position))
+        return 0;
+
+    const Cursor cursor = makeCursor(position, rate);
+    const int numReading = countFramesBefore(cursor, source.length, output.numSamples);
+
+    if (interpolation == Interpolation::Sinc)
+        mixSinc(source, cursor, leftGain, rightGain, output, numReading, false);
+    else
+        mixRange(source, cursor, leftGain, rightGain, output, interpolation, 0, numReading);
+
+    return numReading;
+}
+
+void fillRamp(float* destination, int numSamples, float start, float step)
+{
+    int k = 0;
+
+   #if SYNTHOFLIFE_MIX_AVX2
+    const __m256 lanes = _mm256_setr_ps(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+    const __m256 startVector = _mm256_set1_ps(start);
+    const __m256 stepVector = _mm256_set1_ps(step);
+
+    for (; k + 8 <= numSamples; k += 8)
+    {
+        const __m256 index = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(k)), lanes);
+        _mm256_storeu_ps(destination + k, _mm256_add_ps(startVector, _mm256_mul_ps(index, stepVector)));
+    }
+   #elif SYNTHOFLIFE_MIX_SSE2
+    const __m128 lanes = _mm_setr_ps(1.0f, 2.0f, 3.0f, 4.0f);
+    const __m128 startVector = _mm_set1_ps(start);
+    const __m128 stepVector = _mm_set1_ps(step);
+
+    for (; k + 4 <= numSamples; k += 4)
+    {
+        const __m128 index = _mm_add_ps(_mm_set1_ps(static_cast<float>(k)), lanes);
+        _mm_storeu_ps(destination + k, _mm_add_ps(startVector, _mm_mul_ps(index, stepVector)));
+    }
+   #endif
+
+    for (; k < numSamples; ++k)
+        destination[k] = start + static_cast<float>(k + 1) * step;
+}
+
+void prepareTables()
+{
+    getSincTables();
+}
+
+const char* getImplementationName()
+{
+   #if SYNTHOFLIFE_MIX_AVX2
+    return "AVX2";
+   #elif SYNTHOFLIFE_MIX_SSE2
+    return "SSE2";
+   #else
+    return "scalar";
+   #endif
+}
+}
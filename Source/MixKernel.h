@@ -0,0 +1,71 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/**
+ * Resampling and mixing of one voice into an output block.
+ *
+ * The source is read at a fractional position that moves by the playback rate each output
+ * sample, interpolated, scaled by a gain per output channel and added to the output. The output
+ * channels are processed together, so each source frame is gathered once.
+ *
+ * Interpolation trades CPU for fidelity: linear (2 points), 4-point cubic (Catmull-Rom), or a
+ * Kaiser-windowed sinc read from precomputed polyphase tables. The sinc tables come in bands of
+ * playback rate, six to the octave, each with its cutoff lowered (and its length stretched) to
+ * match, so pitching a sample up does not fold its top octave back down as aliasing, and a small
+ * pitch change does not cost much of the passband.
+ *
+ * The kernel is vectorised with AVX2 when the build targets it (SYNTHOFLIFE_ENABLE_AVX2), with
+ * SSE2 on any other x86 build, and falls back to scalar code elsewhere. All versions compute the
+ * interpolation positions the same way, so their results agree to within float rounding.
+ */
+namespace MixKernel
+{
+    // Interpolation between source frames (in the order of the resampling quality choices)
+    enum class Interpolation
+    {
+        Linear = 0,
+        Cubic,
+        Sinc,
+        NumQualities
+    };
+
+    // One voice's source: left and right channels (the same pointer for a mono sample)
+    struct Source
+    {
+        const float* left = nullptr;
+        const float* right = nullptr;
+        int length = 0;
+    };
+
+    // Output block: right may be null for a mono output. envelope, if set, holds a gain for
+    // each output sample, applied on top of the channel gains.
+    struct Output
+    {
+        float* left = nullptr;
+        float* right = nullptr;
+        int numSamples = 0;
+        const float* envelope = nullptr;
+    };
+
+    /**
+     * Add the source, starting at position and advancing by rate per sample, into output with
+     * the given channel gains. Stops early where the source runs out.
+     * Returns the number of output samples that read from the source.
+     */
+    int mix(const Source& source, double position, float rate, float leftGain, float rightGain, const Output& output,
+            Interpolation interpolation = Interpolation::Linear);
+
+    // Plain scalar version, for reference and benchmarks
+    int mixScalar(const Source& source, double position, float rate, float leftGain, float rightGain, const Output& output,
+                  Interpolation interpolation = Interpolation::Linear);
+
+    // Write the linear ramp start + step, start + 2 * step, ... (an envelope segment) to destination
+    void fillRamp(float* destination, int numSamples, float start, float step);
+
+    // Build the sinc tables, so the first sinc-interpolated block does not pay for it
+    void prepareTables();
+
+    // Name of the instruction set mix() was built for
+    const char* getImplementationName();
+}
@@ -114,6 +114,26 @@ juce::AudioProcessorValueTreeState::ParameterLayout ParameterManager::createPara
             "Sample " + juce::String(i + 1) + " Output",
             outputChoices,
             0)); // Default to main output (0)
+            
+        // What a cell's age modulates when it triggers this sample
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "age_mod_" + juce::String(i),
+            "Sample " + juce::String(i + 1) + " Age Modulation",
+            juce::StringArray { "Off", "Velocity", "Envelope", "Pitch" },
+            0)); // Default to off
+            
+        // Where the cell events go: internal voices, MIDI output, or both
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "pad_output_mode_" + juce::String(i),
+            "Sample " + juce::String(i + 1) + " Output Mode",
+            juce::StringArray { "Sampler", "MIDI", "Sampler + MIDI" },
+            0)); // Default to the sampler only
+            
+        // MIDI output channel
+        layout.add(std::make_unique<juce::AudioParameterInt>(
+            "midi_channel_" + juce::String(i),
+            "Sample " + juce::String(i + 1) + " MIDI Channel",
+            1, 16, 10)); // Default to the GM drum channel
     }
     
     // Interval parameters for Game of Life
@@ -166,6 +186,81 @@ juce::AudioProcessorValueTreeState::ParameterLayout ParameterManager::createPara
         "Max Timing Delay",
         10.0f, 1000.0f, 160.0f));  // Range 10-1000ms (1 second), default 160ms
         
+    // Grid dimension parameters
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        "gridWidth",
+        "Grid Width",
+        MIN_GRID_SIZE, MAX_GRID_SIZE, GRID_SIZE));
+        
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        "gridHeight",
+        "Grid Height",
+        MIN_GRID_SIZE, MAX_GRID_SIZE, GRID_SIZE));
+        
+    // Column folding parameter
+    juce::StringArray columnFoldingChoices = { "Modulo", "Range Bands", "User Map" };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "columnFolding",
+        "Column Folding",
+        columnFoldingChoices,
+        0));  // Default to modulo
+        
+    // Life rule parameters (the presets, then the custom rulestring)
+    juce::StringArray lifeRuleChoices;
+    for (const auto& preset : GameOfLifeApp::LIFE_RULE_PRESETS)
+        lifeRuleChoices.add(juce::String(preset.name) + " (" + preset.ruleString + ")");
+    lifeRuleChoices.add("Custom");
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "lifeRule",
+        "Life Rule",
+        lifeRuleChoices,
+        0));  // Default to Conway
+        
+    // Automatic reseed parameter
+    juce::StringArray autoReseedChoices = { "Off", "When Static", "When Cycling" };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "autoReseed",
+        "Auto Reseed",
+        autoReseedChoices,
+        0));  // Default to off
+        
+    // Seed of the random grids (kept below 2^24 so it is stored exactly)
+    layout.add(std::make_unique<juce::AudioParameterInt>(
+        "gridSeed",
+        "Grid Seed",
+        0, MAX_GRID_SEED, 1));
+        
+    // Clock source parameter
+    juce::StringArray clockSourceChoices = { "Host", "MIDI Clock" };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "clockSource",
+        "Clock Source",
+        clockSourceChoices,
+        0));  // Default to the host
+        
+    // Resampling quality of the pitched samples, chosen separately for real-time playback and
+    // offline rendering (in the order of MixKernel::Interpolation)
+    juce::StringArray resamplingChoices = { "Linear", "Cubic", "Sinc" };
+    
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "realtimeResampling",
+        "Realtime Resampling",
+        resamplingChoices,
+        1));  // Default to cubic
+        
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "offlineResampling",
+        "Offline Resampling",
+        resamplingChoices,
+        2));  // Default to sinc
+        
+    juce::StringArray sectionRuleChoices = lifeRuleChoices;
+    sectionRuleChoices.insert(0, "Global");
+    
     // Add section iteration parameters
     for (int i = 0; i < 4; ++i)
     {
@@ -192,6 +287,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout ParameterManager::createPara
             "section_density_" + juce::String(i),
             "Section " + juce::String(i + 1) + " Density",
             0.1f, 0.9f, 0.5f));  // Range 0.1-0.9, default 0.5
+            
+        // Section rule parameter
+        layout.add(std::make_unique<juce::AudioParameterChoice>(
+            "section_rule_" + juce::String(i),
+            "Section " + juce::String(i + 1) + " Rule",
+            sectionRuleChoices,
+            0));  // Default to the global rule
     }
     
     return layout;
@@ -215,6 +317,9 @@ void ParameterManager::initializeParameters()
     sustainParams.resize(NUM_SAMPLES);
     releaseParams.resize(NUM_SAMPLES);
     outputParams.resize(NUM_SAMPLES);
+    ageModulationParams.resize(NUM_SAMPLES);
+    padOutputModeParams.resize(NUM_SAMPLES);
+    midiChannelParams.resize(NUM_SAMPLES);
     
     // Get parameter pointers
     for (int i = 0; i < NUM_SAMPLES; ++i)
@@ -234,6 +339,9 @@ void ParameterManager::initializeParameters()
         sustainParams[i] = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("sustain_" + juce::String(i)));
         releaseParams[i] = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("release_" + juce::String(i)));
         outputParams[i] = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("output_" + juce::String(i)));
+        ageModulationParams[i] = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("age_mod_" + juce::String(i)));
+        padOutputModeParams[i] = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("pad_output_mode_" + juce::String(i)));
+        midiChannelParams[i] = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("midi_channel_" + juce::String(i)));
     }
     
     // Get global parameter pointers
@@ -242,6 +350,23 @@ void ParameterManager::initializeParameters()
     musicalScaleParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("musicalScale"));
     rootNoteParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("rootNote"));
     maxTimingDelayParam = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("maxTimingDelay"));
+    gridWidthParam = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("gridWidth"));
+    gridHeightParam = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("gridHeight"));
+    columnFoldingParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("columnFolding"));
+    lifeRuleParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("lifeRule"));
+    autoReseedParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("autoReseed"));
+    gridSeedParam = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("gridSeed"));
+    clockSourceParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("clockSource"));
+    realtimeResamplingParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("realtimeResampling"));
+    offlineResamplingParam = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("offlineResampling"));
+    
+    // Parse the preset rules
+    for (int i = 0; i < GameOfLifeApp::NUM_LIFE_RULE_PRESETS; ++i)
+    {
+        bool valid = GameOfLifeApp::LifeRule::parse(GameOfLifeApp::LIFE_RULE_PRESETS[i].ruleString, presetRules[i]);
+        jassert(valid);
+        juce::ignoreUnused(valid);
+    }
     
     // Get section iteration parameter pointers
     for (int i = 0; i < 4; ++i)
@@ -250,6 +375,7 @@ void ParameterManager::initializeParameters()
         sectionGridStateParams[i] = dynamic_cast<juce::AudioParameterInt*>(apvts.getParameter("section_grid_state_" + juce::String(i)));
         sectionRandomizeParams[i] = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter("section_randomize_" + juce::String(i)));
         sectionDensityParams[i] = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter("section_density_" + juce::String(i)));
+        sectionRuleParams[i] = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter("section_rule_" + juce::String(i)));
     }
 }
 
@@ -373,6 +499,30 @@ juce::AudioParameterChoice* ParameterManager::getOutputParam(int sampleIndex)
     return nullptr;
 }
 
+juce::AudioParameterChoice* ParameterManager::getAgeModulationParam(int sampleIndex)
+{
+    if (sampleIndex >= 0 && sampleIndex < NUM_SAMPLES)
+        return ageModulationParams[sampleIndex];
+        
+    return nullptr;
+}
+
+juce::AudioParameterChoice* ParameterManager::getPadOutputModeParam(int sampleIndex)
+{
+    if (sampleIndex >= 0 && sampleIndex < NUM_SAMPLES)
+        return padOutputModeParams[sampleIndex];
+        
+    return nullptr;
+}
+
+juce::AudioParameterInt* ParameterManager::getMidiChannelParam(int sampleIndex)
+{
+    if (sampleIndex >= 0 && sampleIndex < NUM_SAMPLES)
+        return midiChannelParams[sampleIndex];
+        
+    return nullptr;
+}
+
 juce::AudioParameterChoice* ParameterManager::getIntervalTypeParam()
 {
     return intervalTypeParam;
@@ -398,6 +548,51 @@ juce::AudioParameterFloat* ParameterManager::getMaxTimingDelayParam()
     return maxTimingDelayParam;
 }
 
+juce::AudioParameterInt* ParameterManager::getGridWidthParam()
+{
+    return gridWidthParam;
+}
+
+juce::AudioParameterInt* ParameterManager::getGridHeightParam()
+{
+    return gridHeightParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getColumnFoldingParam()
+{
+    return columnFoldingParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getLifeRuleParam()
+{
+    return lifeRuleParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getAutoReseedParam()
+{
+    return autoReseedParam;
+}
+
+juce::AudioParameterInt* ParameterManager::getGridSeedParam()
+{
+    return gridSeedParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getClockSourceParam()
+{
+    return clockSourceParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getRealtimeResamplingParam()
+{
+    return realtimeResamplingParam;
+}
+
+juce::AudioParameterChoice* ParameterManager::getOfflineResamplingParam()
+{
+    return offlineResamplingParam;
+}
+
 juce::AudioParameterInt* ParameterManager::getSectionBarsParam(int sectionIndex)
 {
     if (sectionIndex >= 0 && sectionIndex < 4)
@@ -430,6 +625,100 @@ juce::AudioParameterFloat* ParameterManager::getSectionDensityParam(int sectionI
     return nullptr;
 }
 
+juce::AudioParameterChoice* ParameterManager::getSectionRuleParam(int sectionIndex)
+{
+    if (sectionIndex >= 0 && sectionIndex < 4)
+        return sectionRuleParams[sectionIndex];
+        
+    return nullptr;
+}
+
+void ParameterManager::setActiveSection(int sectionIndex)
+{
+    activeSection = juce::jlimit(0, 3, sectionIndex);
+}
+
+int ParameterManager::getActiveSection() const
+{
+    return activeSection.load();
+}
+
+AutoReseed ParameterManager::getAutoReseed() const
+{
+    if (autoReseedParam != nullptr)
+    {
+        return static_cast<AutoReseed>(autoReseedParam->getIndex());
+    }
+    
+    return AutoReseed::Off; // Default to off
+}
+
+int ParameterManager::getGridSeed() const
+{
+    if (gridSeedParam != nullptr)
+    {
+        return gridSeedParam->get();
+    }
+    
+    return 1;
+}
+
+ClockSource ParameterManager::getClockSource() const
+{
+    if (clockSourceParam != nullptr)
+    {
+        return static_cast<ClockSource>(clockSourceParam->getIndex());
+    }
+    
+    return ClockSource::Host; // Default to the host
+}
+
+bool ParameterManager::setCustomRule(const juce::String& ruleString)
+{
+    GameOfLifeApp::LifeRule rule;
+    if (!GameOfLifeApp::LifeRule::parse(ruleString, rule))
+        return false;
+    
+    customRule = rule.pack();
+    
+    // Store the rule with the plugin state
+    apvts.state.setProperty("customRule", rule.toString(), nullptr);
+    return true;
+}
+
+juce::String ParameterManager::getCustomRule() const
+{
+    return GameOfLifeApp::LifeRule::unpack(customRule.load()).toString();
+}
+
+void ParameterManager::restoreCustomRuleFromState()
+{
+    // Fall back to Conway if the state has no (valid) custom rule
+    if (!setCustomRule(apvts.state.getProperty("customRule", "B3/S23").toString()))
+        setCustomRule("B3/S23");
+}
+
+GameOfLifeApp::LifeRule ParameterManager::getRuleForChoice(int choiceIndex) const
+{
+    if (choiceIndex >= 0 && choiceIndex < GameOfLifeApp::NUM_LIFE_RULE_PRESETS)
+        return presetRules[choiceIndex];
+        
+    return GameOfLifeApp::LifeRule::unpack(customRule.load());
+}
+
+GameOfLifeApp::LifeRule ParameterManager::getActiveRule() const
+{
+    // A section rule of 0 means "Global"
+    auto* sectionRuleParam = sectionRuleParams[activeSection.load()];
+    if (sectionRuleParam != nullptr && sectionRuleParam->getIndex() > 0)
+        return getRuleForChoice(sectionRuleParam->getIndex() - 1);
+    
+    if (lifeRuleParam != nullptr)
+        return getRuleForChoice(lifeRuleParam->getIndex());
+    
+    return GameOfLifeApp::LifeRule::conway();
+}
+
 MusicalScale ParameterManager::getSelectedScale() const
 {
     if (musicalScaleParam != nullptr)
@@ -440,13 +729,124 @@ MusicalScale ParameterManager::getSelectedScale() const
     return MusicalScale::Pentatonic; // Default to pentatonic
 }
 
+int ParameterManager::getGridWidth() const
+{
+    return gridWidthParam != nullptr ? gridWidthParam->get() : GRID_SIZE;
+}
+
+int ParameterManager::getGridHeight() const
+{
+    return gridHeightParam != nullptr ? gridHeightParam->get() : GRID_SIZE;
+}
+
+ColumnFolding ParameterManager::getColumnFolding() const
+{
+    if (columnFoldingParam != nullptr)
+    {
+        return static_cast<ColumnFolding>(columnFoldingParam->getIndex());
+    }
+    
+    return ColumnFolding::Modulo; // Default to modulo
+}
+
+void ParameterManager::setColumnPadMap(const juce::String& mapString)
+{
+    // Parse the 1-based pad numbers, ignoring anything out of range
+    juce::StringArray tokens;
+    tokens.addTokens(mapString, " ,;", "");
+    tokens.removeEmptyStrings();
+    
+    ColumnPadMap map;
+    for (const auto& token : tokens)
+    {
+        int pad = token.getIntValue();
+        if (pad >= 1 && pad <= NUM_SAMPLES && map.length < MAX_GRID_SIZE)
+            map.pads[static_cast<size_t>(map.length++)] = pad - 1;
+    }
+    
+    // Publish it under the sequence lock: the version is odd until the new map is complete
+    const int version = columnPadMapVersion.load(std::memory_order_relaxed);
+    columnPadMapVersion.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    for (int i = 0; i < map.length; ++i)
+        columnPadMap[static_cast<size_t>(i)].store(map.pads[static_cast<size_t>(i)], std::memory_order_relaxed);
+    
+    columnPadMapLength.store(map.length, std::memory_order_relaxed);
+    columnPadMapVersion.store(version + 2, std::memory_order_release);
+    
+    // Store the map with the plugin state
+    apvts.state.setProperty("columnPadMap", mapString, nullptr);
+}
+
+juce::String ParameterManager::getColumnPadMap() const
+{
+    return apvts.state.getProperty("columnPadMap", "").toString();
+}
+
+void ParameterManager::restoreColumnPadMapFromState()
+{
+    setColumnPadMap(getColumnPadMap());
+}
+
+bool ParameterManager::copyColumnPadMap(ColumnPadMap& map, int& version) const
+{
+    const int startVersion = columnPadMapVersion.load(std::memory_order_acquire);
+    if ((startVersion & 1) != 0)
+        return false;
+    
+    ColumnPadMap copy;
+    copy.length = juce::jlimit(0, MAX_GRID_SIZE, columnPadMapLength.load(std::memory_order_relaxed));
+    
+    for (int i = 0; i < copy.length; ++i)
+        copy.pads[static_cast<size_t>(i)] = columnPadMap[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+    
+    // The copy only counts if no new map was started while it was taken
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (columnPadMapVersion.load(std::memory_order_relaxed) != startVersion)
+        return false;
+    
+    map = copy;
+    version = startVersion;
+    return true;
+}
+
 int ParameterManager::getSampleForColumn(int column) const
 {
-    // Direct 1:1 mapping between columns and samples
-    if (column >= 0 && column < NUM_SAMPLES)
-        return column;
-        
-    return -1; // Invalid column
+    // The map is only set on the message thread, so a copy taken there never has to wait long
+    ColumnPadMap map;
+    int version = 0;
+    
+    if (getColumnFolding() == ColumnFolding::UserMap)
+        while (! copyColumnPadMap(map, version)) {}
+    
+    return getSampleForColumn(column, map);
+}
+
+int ParameterManager::getSampleForColumn(int column, const ColumnPadMap& map) const
+{
+    int gridWidth = getGridWidth();
+    
+    if (column < 0 || column >= gridWidth)
+        return -1; // Invalid column
+    
+    switch (getColumnFolding())
+    {
+        case ColumnFolding::RangeBands:
+            // Split the grid into NUM_SAMPLES contiguous bands of columns
+            return juce::jmin(NUM_SAMPLES - 1, column * NUM_SAMPLES / gridWidth);
+            
+        case ColumnFolding::UserMap:
+            // Repeat the user map across the grid (fall back to modulo if it is empty)
+            if (map.length > 0)
+                return map.pads[static_cast<size_t>(column % map.length)];
+            return column % NUM_SAMPLES;
+            
+        case ColumnFolding::Modulo:
+        default:
+            // Wrap the columns around the pads (1:1 mapping on a 16-column grid)
+            return column % NUM_SAMPLES;
+    }
 }
 
 ColumnControlMode ParameterManager::getControlModeForColumn(int column) const
@@ -594,10 +994,34 @@ int ParameterManager::getOutputForSample(int sampleIndex) const
     return 0; // Default to main output
 }
 
+PadOutputMode ParameterManager::getPadOutputModeForSample(int sampleIndex) const
+{
+    if (sampleIndex >= 0 && sampleIndex < NUM_SAMPLES && padOutputModeParams[sampleIndex] != nullptr)
+    {
+        return static_cast<PadOutputMode>(padOutputModeParams[sampleIndex]->getIndex());
+    }
+    
+    return PadOutputMode::Sampler; // Default to the sampler only
+}
+
+int ParameterManager::getMidiChannelForSample(int sampleIndex) const
+{
+    if (sampleIndex >= 0 && sampleIndex < NUM_SAMPLES && midiChannelParams[sampleIndex] != nullptr)
+    {
+        return midiChannelParams[sampleIndex]->get();
+    }
+    
+    return 10; // Default to the GM drum channel
+}
+
 int ParameterManager::getPitchOffsetForRow(int row) const
 {
+    // Scale the row onto GRID_SIZE pitch steps so taller grids keep the same pitch range
+    int gridHeight = getGridHeight();
+    int scaledRow = juce::jlimit(0, GRID_SIZE - 1, row * GRID_SIZE / gridHeight);
+    
     // Invert row index (0 is top row in the grid, but we want the bottom row to be the lowest pitch)
-    int invertedRow = GRID_SIZE - 1 - row;
+    int invertedRow = GRID_SIZE - 1 - scaledRow;
     
     // Get the selected scale
     MusicalScale scale = getSelectedScale();
@@ -624,9 +1048,10 @@ float ParameterManager::getTimingDelayForRow(int row) const
     // Get the maximum timing delay
     float maxDelay = maxTimingDelayParam != nullptr ? maxTimingDelayParam->get() : 160.0f;
     
-    // Calculate the delay based on the row (0 is top row, GRID_SIZE-1 is bottom row)
+    // Calculate the delay based on the row (0 is top row, height-1 is bottom row)
     // Map row to a value between 0 and 1
-    float normalizedRow = static_cast<float>(row) / static_cast<float>(GRID_SIZE - 1);
+    int gridHeight = getGridHeight();
+    float normalizedRow = static_cast<float>(row) / static_cast<float>(juce::jmax(1, gridHeight - 1));
     
     // Map to delay (0 to maxDelay)
     return normalizedRow * maxDelay;
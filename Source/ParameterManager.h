@@ -1,6 +1,9 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include "LifeRule.h"
 
 // Forward declaration
 class GameOfLife;
@@ -32,6 +35,41 @@ enum class ColumnControlMode
     Both = Velocity | Timing
 };
 
+// How grid columns are folded onto the sample pads
+enum class ColumnFolding
+{
+    Modulo = 0,     // column % NUM_SAMPLES
+    RangeBands,     // contiguous bands of columns per pad
+    UserMap,        // repeating user-defined column-to-pad map
+    NumFoldings
+};
+
+// When to reseed the grid automatically once the automaton has settled
+enum class AutoReseed
+{
+    Off = 0,
+    WhenStatic,     // extinct or still life
+    WhenCycling,    // extinct, still life, or oscillating
+    NumModes
+};
+
+// Where a pad's cell events go
+enum class PadOutputMode
+{
+    Sampler = 0,        // the pad's internal sample voices
+    Midi,               // note events on the MIDI output only
+    SamplerAndMidi,     // both
+    NumModes
+};
+
+// What steps the generations
+enum class ClockSource
+{
+    Host = 0,       // the host's transport, or free-running when it is stopped
+    MidiClock,      // 24 PPQN MIDI clock messages on the MIDI input
+    NumSources
+};
+
 // Musical scales
 enum class MusicalScale
 {
@@ -48,8 +86,11 @@ class ParameterManager
 {
 public:
     static const int NUM_SAMPLES = 16; 
-    static const int GRID_SIZE = 16;
+    static const int GRID_SIZE = 16;      // Default grid width and height
+    static const int MIN_GRID_SIZE = 4;
+    static const int MAX_GRID_SIZE = 256;
     static const int NUM_OUTPUTS = 17; // Main output (0) + 16 additional outputs (1-16)
+    static const int MAX_GRID_SEED = 9999999;
     
     ParameterManager(juce::AudioProcessor& processor);
     ~ParameterManager();
@@ -76,22 +117,98 @@ public:
     juce::AudioParameterFloat* getSustainParam(int sampleIndex);
     juce::AudioParameterFloat* getReleaseParam(int sampleIndex);
     juce::AudioParameterChoice* getOutputParam(int sampleIndex);
+    juce::AudioParameterChoice* getAgeModulationParam(int sampleIndex);
+    juce::AudioParameterChoice* getPadOutputModeParam(int sampleIndex);
+    juce::AudioParameterInt* getMidiChannelParam(int sampleIndex);
     
     juce::AudioParameterChoice* getIntervalTypeParam();
     juce::AudioParameterChoice* getIntervalValueParam();
     juce::AudioParameterChoice* getScaleParam();
     juce::AudioParameterChoice* getRootNoteParam();
     juce::AudioParameterFloat* getMaxTimingDelayParam();
+    juce::AudioParameterInt* getGridWidthParam();
+    juce::AudioParameterInt* getGridHeightParam();
+    juce::AudioParameterChoice* getColumnFoldingParam();
+    juce::AudioParameterChoice* getLifeRuleParam();
+    juce::AudioParameterChoice* getAutoReseedParam();
+    juce::AudioParameterInt* getGridSeedParam();
+    juce::AudioParameterChoice* getClockSourceParam();
+    juce::AudioParameterChoice* getRealtimeResamplingParam();
+    juce::AudioParameterChoice* getOfflineResamplingParam();
     
     // Section iteration parameters
     juce::AudioParameterInt* getSectionBarsParam(int sectionIndex);
     juce::AudioParameterInt* getSectionGridStateParam(int sectionIndex);
     juce::AudioParameterBool* getSectionRandomizeParam(int sectionIndex);
     juce::AudioParameterFloat* getSectionDensityParam(int sectionIndex);
+    juce::AudioParameterChoice* getSectionRuleParam(int sectionIndex);
+    
+    // Set the section currently being played (selects which section rule applies)
+    void setActiveSection(int sectionIndex);
+    
+    // Get the section currently being played
+    int getActiveSection() const;
+    
+    // Get the automatic reseed mode
+    AutoReseed getAutoReseed() const;
+    
+    // Get the seed of the random grids
+    int getGridSeed() const;
+    
+    // Get the clock that steps the generations
+    ClockSource getClockSource() const;
+    
+    // Set the custom rule from a B/S rulestring (e.g. "B36/S23"). The rule is stored with the
+    // plugin state. Returns false if the rulestring is invalid.
+    bool setCustomRule(const juce::String& ruleString);
+    
+    // Get the custom rule as a rulestring
+    juce::String getCustomRule() const;
     
-    // Get sample for column (now direct 1:1 mapping)
+    // Re-read the custom rule after the plugin state has been replaced
+    void restoreCustomRuleFromState();
+    
+    // Get the rule in effect: the active section's rule, or the global rule if the section uses it
+    GameOfLifeApp::LifeRule getActiveRule() const;
+    
+    // Get the grid dimensions
+    int getGridWidth() const;
+    int getGridHeight() const;
+    
+    // Get the column folding rule
+    ColumnFolding getColumnFolding() const;
+    
+    // Set the user column-to-pad map from a list of 1-based pad numbers (e.g. "1 1 2 2 3 3"),
+    // repeated across the grid width. The map is stored with the plugin state.
+    void setColumnPadMap(const juce::String& mapString);
+    
+    // Get the user column-to-pad map as text
+    juce::String getColumnPadMap() const;
+    
+    // Re-read the user column-to-pad map after the plugin state has been replaced
+    void restoreColumnPadMapFromState();
+    
+    // Changes every time the user column-to-pad map is set, so caches of it can tell it has
+    // changed (the map is not a parameter, so it has no parameter listeners)
+    int getColumnPadMapVersion() const { return columnPadMapVersion.load(); }
+    
+    // A copy of the user column-to-pad map (0-based pad indices)
+    struct ColumnPadMap
+    {
+        std::array<int, MAX_GRID_SIZE> pads {};
+        int length = 0;
+    };
+    
+    // Copy the user column-to-pad map and its version, without waiting; safe from any thread.
+    // Returns false, leaving map alone, if the map was being set at the same time.
+    bool copyColumnPadMap(ColumnPadMap& map, int& version) const;
+    
+    // Get sample for column (folds the grid columns onto the pads)
     int getSampleForColumn(int column) const;
     
+    // Get sample for column, folding with a copy of the user map taken by copyColumnPadMap()
+    int getSampleForColumn(int column, const ColumnPadMap& map) const;
+    
     // Get control mode for column (now maps to the sample's control mode)
     ColumnControlMode getControlModeForColumn(int column) const;
     
@@ -131,11 +248,18 @@ public:
     // Get output bus for a specific sample
     int getOutputForSample(int sampleIndex) const;
     
+    // Get where a sample's cell events go (internal voices and/or MIDI output)
+    PadOutputMode getPadOutputModeForSample(int sampleIndex) const;
+    
+    // Get the MIDI output channel (1-16) of a specific sample
+    int getMidiChannelForSample(int sampleIndex) const;
+    
     // Get the selected musical scale
     MusicalScale getSelectedScale() const;
     
     // Get pitch offset for a row based on the selected scale
-    // Row 0 is the top row, row (GRID_SIZE-1) is the bottom row
+    // Row 0 is the top row, row (height-1) is the bottom row; taller grids are
+    // scaled onto the same GRID_SIZE pitch steps
     // Returns a semitone offset in the range -7 to +8
     int getPitchOffsetForRow(int row) const;
     
@@ -171,16 +295,46 @@ private:
     std::vector<juce::AudioParameterFloat*> sustainParams;
     std::vector<juce::AudioParameterFloat*> releaseParams;
     std::vector<juce::AudioParameterChoice*> outputParams;
+    std::vector<juce::AudioParameterChoice*> ageModulationParams;
+    std::vector<juce::AudioParameterChoice*> padOutputModeParams;
+    std::vector<juce::AudioParameterInt*> midiChannelParams;
     
     juce::AudioParameterChoice* intervalTypeParam = nullptr;
     juce::AudioParameterChoice* intervalValueParam = nullptr;
     juce::AudioParameterChoice* musicalScaleParam = nullptr;
     juce::AudioParameterChoice* rootNoteParam = nullptr;
     juce::AudioParameterFloat* maxTimingDelayParam = nullptr;
+    juce::AudioParameterInt* gridWidthParam = nullptr;
+    juce::AudioParameterInt* gridHeightParam = nullptr;
+    juce::AudioParameterChoice* columnFoldingParam = nullptr;
+    
+    juce::AudioParameterChoice* lifeRuleParam = nullptr;
+    juce::AudioParameterChoice* autoReseedParam = nullptr;
+    juce::AudioParameterInt* gridSeedParam = nullptr;
+    juce::AudioParameterChoice* clockSourceParam = nullptr;
+    juce::AudioParameterChoice* realtimeResamplingParam = nullptr;
+    juce::AudioParameterChoice* offlineResamplingParam = nullptr;
+    
+    // Custom rule (packed LifeRule) and the section being played, read on the audio thread
+    std::atomic<uint32_t> customRule { GameOfLifeApp::LifeRule::conway().pack() };
+    std::atomic<int> activeSection { 0 };
+    
+    // Preset rules, parsed once so the audio thread never handles rulestrings
+    std::array<GameOfLifeApp::LifeRule, GameOfLifeApp::NUM_LIFE_RULE_PRESETS> presetRules;
+    
+    // Rule for a preset choice index (NUM_LIFE_RULE_PRESETS selects the custom rule)
+    GameOfLifeApp::LifeRule getRuleForChoice(int choiceIndex) const;
+    
+    // Parsed user column-to-pad map (0-based pad indices). Set on the message thread and copied
+    // by the audio thread under a sequence lock: the version is odd while the map is being set.
+    std::array<std::atomic<int>, MAX_GRID_SIZE> columnPadMap {};
+    std::atomic<int> columnPadMapLength { 0 };
+    std::atomic<int> columnPadMapVersion { 0 };
     
     // Section iteration parameters
     juce::AudioParameterInt* sectionBarsParams[4] = { nullptr };
     juce::AudioParameterInt* sectionGridStateParams[4] = { nullptr };
     juce::AudioParameterBool* sectionRandomizeParams[4] = { nullptr };
     juce::AudioParameterFloat* sectionDensityParams[4] = { nullptr };
+    juce::AudioParameterChoice* sectionRuleParams[4] = { nullptr };
 };
@@ -24,6 +24,11 @@ DrumMachineAudioProcessorEditor::DrumMachineAudioProcessorEditor (DrumMachineAud
       noteActivityIndicator(),
       scaleSelector(),
       scaleSelectorLabel(),
+      clockSourceLabel(),
+      clockSourceBox(),
+      resamplingLabel(),
+      realtimeResamplingBox(),
+      offlineResamplingBox(),
       intervalLabel(),
       intervalTypeBox(),
       intervalValueBox(),
@@ -126,6 +131,16 @@ DrumMachineAudioProcessorEditor::DrumMachineAudioProcessorEditor (DrumMachineAud
         sections[i].densityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
             p.getParameterManager().getAPVTS(), "section_density_" + juce::String(i), sections[i].densitySlider);
         
+        // Set up rule label and combo box
+        sections[i].ruleLabel.setText("Rule:", juce::dontSendNotification);
+        sections[i].ruleLabel.setJustificationType(juce::Justification::right);
+        
+        sections[i].ruleBox.addItemList(p.getParameterManager().getSectionRuleParam(i)->choices, 1);
+        
+        // Create parameter attachment for rule combo box
+        sections[i].ruleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            p.getParameterManager().getAPVTS(), "section_rule_" + juce::String(i), sections[i].ruleBox);
+        
         // Initialize section state
         sections[i].isActive = (i == 0); // First section is active by default
         
@@ -167,6 +182,31 @@ DrumMachineAudioProcessorEditor::DrumMachineAudioProcessorEditor (DrumMachineAud
     intervalValueAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         p.getParameterManager().getAPVTS(), "intervalValue", intervalValueBox);
     
+    // Set up the clock source selector
+    clockSourceLabel.setText("Clock:", juce::dontSendNotification);
+    clockSourceLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    
+    clockSourceBox.addItemList(p.getParameterManager().getClockSourceParam()->choices, 1);
+    clockSourceBox.setTooltip("Step the grid with the host, or slave it to MIDI clock on the MIDI input");
+    
+    clockSourceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        p.getParameterManager().getAPVTS(), "clockSource", clockSourceBox);
+    
+    // Set up the resampling quality selectors
+    resamplingLabel.setText("Resampling:", juce::dontSendNotification);
+    resamplingLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    
+    realtimeResamplingBox.addItemList(p.getParameterManager().getRealtimeResamplingParam()->choices, 1);
+    realtimeResamplingBox.setTooltip("Interpolation of pitched samples during real-time playback");
+    
+    offlineResamplingBox.addItemList(p.getParameterManager().getOfflineResamplingParam()->choices, 1);
+    offlineResamplingBox.setTooltip("Interpolation of pitched samples when the host renders offline");
+    
+    realtimeResamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        p.getParameterManager().getAPVTS(), "realtimeResampling", realtimeResamplingBox);
+    offlineResamplingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        p.getParameterManager().getAPVTS(), "offlineResampling", offlineResamplingBox);
+    
     // Set up maximum timing delay control
     addAndMakeVisible(maxTimingDelayLabel);
     addAndMakeVisible(maxTimingDelaySlider);
@@ -201,6 +241,11 @@ DrumMachineAudioProcessorEditor::DrumMachineAudioProcessorEditor (DrumMachineAud
     // Add components to the main tab
     mainTab.addAndMakeVisible(scaleSelector);
     mainTab.addAndMakeVisible(scaleSelectorLabel);
+    mainTab.addAndMakeVisible(clockSourceLabel);
+    mainTab.addAndMakeVisible(clockSourceBox);
+    mainTab.addAndMakeVisible(resamplingLabel);
+    mainTab.addAndMakeVisible(realtimeResamplingBox);
+    mainTab.addAndMakeVisible(offlineResamplingBox);
     mainTab.addAndMakeVisible(intervalLabel);
     mainTab.addAndMakeVisible(intervalTypeBox);
     mainTab.addAndMakeVisible(intervalValueBox);
@@ -219,6 +264,8 @@ DrumMachineAudioProcessorEditor::DrumMachineAudioProcessorEditor (DrumMachineAud
         mainTab.addAndMakeVisible(sections[i].randomizeLabel);
         mainTab.addAndMakeVisible(sections[i].densityLabel);
         mainTab.addAndMakeVisible(sections[i].densitySlider);
+        mainTab.addAndMakeVisible(sections[i].ruleLabel);
+        mainTab.addAndMakeVisible(sections[i].ruleBox);
     }
     
     // Add components to the drum pad tab
@@ -295,6 +342,10 @@ void DrumMachineAudioProcessorEditor::resized()
     scaleSelectorLabel.setBounds(scaleArea.removeFromLeft(120));
     scaleSelector.setBounds(scaleArea.removeFromLeft(200));
     
+    // Clock source to the right of the scale selector
+    clockSourceLabel.setBounds(scaleArea.removeFromLeft(60));
+    clockSourceBox.setBounds(scaleArea.removeFromLeft(150));
+    
     // Position the interval controls below the scale selector
     auto intervalArea = mainTabArea.removeFromTop(60);
     intervalLabel.setBounds(intervalArea.removeFromLeft(120));
@@ -303,14 +354,23 @@ void DrumMachineAudioProcessorEditor::resized()
     maxTimingDelayLabel.setBounds(intervalArea.removeFromLeft(120));
     maxTimingDelaySlider.setBounds(intervalArea.removeFromLeft(150));
     
+    // Resampling quality for playback and for offline renders
+    auto resamplingArea = mainTabArea.removeFromTop(30);
+    resamplingLabel.setBounds(resamplingArea.removeFromLeft(120));
+    realtimeResamplingBox.setBounds(resamplingArea.removeFromLeft(150));
+    offlineResamplingBox.setBounds(resamplingArea.removeFromLeft(150));
+    
     // Position the section iteration controls
     auto sectionsArea = mainTabArea.removeFromTop(240); // 60 height per section
     for (int i = 0; i < 4; ++i)
     {
         auto sectionArea = sectionsArea.removeFromTop(60);
         
-        // Title label at the top
-        sections[i].titleLabel.setBounds(sectionArea.removeFromTop(20));
+        // Title label at the top, with the section rule on the right
+        auto titleArea = sectionArea.removeFromTop(20);
+        sections[i].ruleBox.setBounds(titleArea.removeFromRight(240));
+        sections[i].ruleLabel.setBounds(titleArea.removeFromRight(50));
+        sections[i].titleLabel.setBounds(titleArea);
         
         // Controls in the remaining area
         auto controlsArea = sectionArea.removeFromTop(30);
@@ -354,8 +414,19 @@ void DrumMachineAudioProcessorEditor::resized()
 
 void DrumMachineAudioProcessorEditor::timerCallback()
 {
-    // Update any UI components that need regular refreshing
-    gameOfLifeComponent.updateGrid();
+    // Hand the events the audio thread journaled since the last tick to the components showing them
+    bool generationAdvanced = false;
+    
+    audioProcessor.getEventJournal().drain([&](const JournalEvent& event) {
+        if (event.type == JournalEvent::Type::Generation)
+            generationAdvanced = true;
+        else
+            drumPadComponent.handleJournalEvent(event);
+    });
+    
+    // Redraw the grid only when it has moved on
+    if (generationAdvanced)
+        gameOfLifeComponent.updateGrid();
     
     // Update the note activity indicator
     noteActivityIndicator.setActive(audioProcessor.isAnyNoteActive());
@@ -459,6 +530,9 @@ void DrumMachineAudioProcessorEditor::updateSectionIteration()
         currentSection = newSection;
         sections[currentSection].isActive = true;
         
+        // Switch to the new section's rule
+        audioProcessor.getParameterManager().setActiveSection(currentSection);
+        
         // Initialize the grid for the new section
         initializeGridForSection(currentSection);
     }
@@ -518,11 +592,8 @@ void DrumMachineAudioProcessorEditor::initializeGridForSection(int sectionIndex)
         DebugLogger::log("Section " + std::to_string(sectionIndex + 1) + 
                          " - Randomizing grid with density: " + std::to_string(density));
         
-        // Randomize the grid with the specified density
-        gameOfLife->initializeWithDensity(density);
-        
-        // Get the new grid state as a string
-        juce::String gridStateStr = gameOfLifeComponent.getGridStateAsString();
+        // Randomize the grid with the specified density, keeping the state string of the cells just drawn
+        juce::String gridStateStr = gameOfLifeComponent.randomizeGrid(density);
         
         // Update the section's grid state text box with the new random state
         sections[sectionIndex].gridStateTextBox.setText(gridStateStr, false);
@@ -64,6 +64,18 @@ private:
     juce::Label scaleSelectorLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> scaleSelectorAttachment;
 
+    // Clock source selector
+    juce::Label clockSourceLabel;
+    juce::ComboBox clockSourceBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> clockSourceAttachment;
+
+    // Resampling quality selectors (real-time playback and offline rendering)
+    juce::Label resamplingLabel;
+    juce::ComboBox realtimeResamplingBox;
+    juce::ComboBox offlineResamplingBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> realtimeResamplingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> offlineResamplingAttachment;
+
     // Interval controls (moved from GameOfLifeComponent)
     juce::Label intervalLabel;
     juce::ComboBox intervalTypeBox;
@@ -87,11 +99,14 @@ private:
         juce::Label randomizeLabel;
         juce::Label densityLabel;
         juce::Slider densitySlider;
+        juce::Label ruleLabel;
+        juce::ComboBox ruleBox;
         
         // Parameter attachments
         std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> barsAttachment;
         std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> randomizeAttachment;
         std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> densityAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> ruleAttachment;
         
         // Current state tracking
         bool isActive = false;
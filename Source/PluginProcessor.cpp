@@ -43,13 +43,24 @@ DrumMachineAudioProcessor::DrumMachineAudioProcessor()
     // Log the number of output buses
     DebugLogger::log("Number of output buses: " + std::to_string(getBusCount(false)));
     
+    // Give each drum pad its voices in the pool
+    for (int i = 0; i < ParameterManager::NUM_SAMPLES; ++i)
+        drumPads[i].setVoicePool(&voicePool, i);
+    
     // Create parameter manager
     parameterManager = std::make_unique<ParameterManager>(*this);
     
     // Create Game of Life with reference to parameter manager
     gameOfLife = std::make_unique<GameOfLife>(parameterManager.get());
     
+    // Create the trigger plan (it listens for changes to the parameters it caches)
+    triggerPlan = std::make_unique<TriggerPlan>(*parameterManager);
+    padEvents.resize(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE));
+    padTriggers.resize(padEvents.size());
+    cellMidiNotes.assign(padEvents.size(), -1);
+    
     // Initialize Game of Life with random cells
+    gameOfLife->setRandomSeed(static_cast<uint64_t>(parameterManager->getGridSeed()));
     gameOfLife->initialize(true);
     
     // Initialize visualization buffer
@@ -59,10 +70,6 @@ DrumMachineAudioProcessor::DrumMachineAudioProcessor()
     // Initialize MIDI note tracking
     activeNotes = std::set<int>();
     mostRecentMidiNote = MIDDLE_C; // Initialize to middle C
-    
-    midiClockEnabled = false;
-    
-    lastGameOfLifeUpdateTime = 0.0; // Initialize last update time
 }
 
 DrumMachineAudioProcessor::~DrumMachineAudioProcessor()
@@ -154,8 +161,23 @@ void DrumMachineAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     visualizationBuffer.setSize(1, samplesPerBlock);
     visualizationBuffer.clear();
     
-    // Reset MIDI clock counter
-    midiClockCounter = 0;
+    // Build the resampling tables now rather than on the first sinc-interpolated block
+    MixKernel::prepareTables();
+    
+    // Forget the MIDI clock; it is measured again on the new sample clock
+    midiClock.prepare(sampleRate);
+    
+    // Restart the random grids from the seed, so a render reseeds the same way every time
+    lastGridSeed = -1;
+    
+    // Room for a busy generation's note events, so the MIDI output rarely allocates
+    midiOutput.ensureSize(MIDI_OUTPUT_RESERVED_BYTES);
+    
+    // Restart the sample clock; pending delayed triggers belong to the old clock
+    sampleClock = 0;
+    lastGenerationSample = 0.0;
+    hostBoundaryValid = false;
+    scheduledSamples.clear();
     
     // Debug output
     DBG("prepareToPlay called with sample rate: " + juce::String(sampleRate) + 
@@ -220,70 +242,89 @@ void DrumMachineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
+    // Apply the UI's grid edits before anything this block can step the grid
+    gameOfLife->applyPendingCommands();
+    
     // Get current playhead info
     juce::AudioPlayHead::CurrentPositionInfo posInfo;
+    bool hasHostPosition = false;
     if (auto* playHead = getPlayHead())
-        playHead->getCurrentPosition(posInfo);
+        hasHostPosition = playHead->getCurrentPosition(posInfo);
         
-    // Calculate current time in seconds
-    double currentTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+    // Note events for the MIDI output are collected here, and replace the incoming MIDI at the end
+    midiOutput.clear();
+    
+    // Pick up any parameter changes before any cell is triggered or pad rendered this block
+    triggerPlan->update();
+    
+    // Apply any change to the grid dimensions and rule before the MIDI can step the grid
+    gameOfLife->setSize(parameterManager->getGridWidth(), parameterManager->getGridHeight());
+    gameOfLife->setRule(parameterManager->getActiveRule());
     
-    // Process any scheduled samples that are due to be triggered
-    processScheduledSamples(currentTime);
+    // Cells removed by the UI's edits or a smaller grid end their notes at the start of the
+    // block, before any new note
+    endRemovedCells(0);
+    
+    // A new seed restarts the sequence of random grids
+    const int gridSeed = parameterManager->getGridSeed();
+    if (gridSeed != lastGridSeed)
+    {
+        gameOfLife->setRandomSeed(static_cast<uint64_t>(gridSeed));
+        lastGridSeed = gridSeed;
+    }
     
     // Process MIDI messages
-    processMidiMessages(midiMessages);
+    processMidiMessages(midiMessages, buffer.getNumSamples());
     
     // If any notes are active, update the Game of Life based on tempo
-    if (isAnyNoteActive())
+    // (MIDI clock ticks step it while the MIDI messages are processed)
+    if (isAnyNoteActive() && parameterManager->getClockSource() != ClockSource::MidiClock)
     {
-        // Always use system time to ensure updates happen regardless of host play state
-        double bpm = 120.0; // Default BPM
-        
-        // Try to get host tempo, but don't rely on host play state
-        juce::AudioPlayHead* playHead = getPlayHead();
-        juce::AudioPlayHead::CurrentPositionInfo posInfo;
-        
-        if (playHead != nullptr && playHead->getCurrentPosition(posInfo))
-        {
-            // Use host tempo if available
-            bpm = posInfo.bpm;
-        }
-        
         // Calculate update interval based on tempo and settings
         int intervalInTicks = calculateIntervalInTicks();
         
-        // Convert MIDI ticks to seconds
-        // MIDI clock sends 24 ticks per quarter note (24 PPQN)
-        // But our intervalInTicks is calculated based on 960 PPQN (JUCE standard)
-        double secondsPerBeat = 60.0 / bpm;
-        double updateIntervalSeconds = secondsPerBeat * (intervalInTicks / 960.0);
-        
-        // Debug output
-        DBG("BPM: " + juce::String(bpm) + 
-            ", Interval in ticks: " + juce::String(intervalInTicks) + 
-            ", Update interval: " + juce::String(updateIntervalSeconds) + " seconds");
-        
-        // Check if it's time to update the grid
-        if (currentTime - lastGameOfLifeUpdateTime >= updateIntervalSeconds)
+        // While the host is playing, generations land exactly on the interval boundaries
+        if (hasHostPosition && posInfo.isPlaying && posInfo.bpm > 0.0)
         {
-            // Update the Game of Life
-            gameOfLife->update();
+            advanceGenerationsWithHost(posInfo, intervalInTicks, buffer.getNumSamples());
+        }
+        else
+        {
+            // The boundaries are counted again from the host position when it next plays
+            hostBoundaryValid = false;
             
-            // Update last update time
-            lastGameOfLifeUpdateTime = currentTime;
+            // Otherwise run free on the sample clock, so updates happen regardless of host play state
+            double bpm = 120.0; // Default BPM
             
-            // Process samples based on the updated grid state
-            processGameOfLife();
+            // Use host tempo if available
+            if (hasHostPosition && posInfo.bpm > 0.0)
+                bpm = posInfo.bpm;
             
-            // Debug output
-            DBG("Grid updated at time: " + juce::String(currentTime));
+            advanceGenerationsFreeRunning(bpm, intervalInTicks, buffer.getNumSamples());
         }
     }
+    else
+    {
+        hostBoundaryValid = false;
+    }
+    
+    // Trigger the rest of the scheduled samples that fall in this block
+    processScheduledSamples(sampleClock + buffer.getNumSamples());
+    
+    // Let the UI see edits and reseeds that were not followed by a generation
+    gameOfLife->publishPendingSnapshot();
+    
+    // Offline renders can afford a better resampler than real-time playback
+    auto* resamplingParam = isNonRealtime() ? parameterManager->getOfflineResamplingParam()
+                                            : parameterManager->getRealtimeResamplingParam();
+    const auto interpolation = resamplingParam != nullptr ? static_cast<MixKernel::Interpolation>(resamplingParam->getIndex())
+                                                          : MixKernel::Interpolation::Linear;
     
     // Update parameters for all drum pads
     for (int i = 0; i < ParameterManager::NUM_SAMPLES; ++i)
     {
+        drumPads[i].setInterpolation(interpolation);
+        
         // Update volume and pan
         drumPads[i].setVolume(parameterManager->getVolumeForSample(i));
         drumPads[i].setPan(parameterManager->getPanForSample(i));
@@ -323,6 +364,13 @@ void DrumMachineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             int outputBus = outputParam->getIndex();
             drumPads[i].setOutputBus(outputBus);
         }
+        
+        // Update what the triggering cell's age modulates
+        auto* ageModulationParam = parameterManager->getAgeModulationParam(i);
+        if (ageModulationParam != nullptr)
+        {
+            drumPads[i].setAgeModulation(static_cast<AgeModulation>(ageModulationParam->getIndex()));
+        }
     }
     
     // Get the number of output buses
@@ -352,6 +400,13 @@ void DrumMachineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     {
         // Skip muted samples
         if (parameterManager->getMuteForSample(i))
+        {
+            drumPads[i].skipBlock(buffer.getNumSamples());
+            continue;
+        }
+        
+        // Skip pads that only send MIDI, once their voices have finished
+        if ((triggerPlan->getPadFlags(i) & TriggerPlan::SAMPLER) == 0 && ! drumPads[i].isPlaying())
             continue;
         
         // Get the output bus for this drum pad
@@ -363,6 +418,10 @@ void DrumMachineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             // Render audio for this drum pad to the appropriate bus buffer
             drumPads[i].renderNextBlockToBus(busBuffers[outputBus], 0, buffer.getNumSamples(), outputBus);
         }
+        else
+        {
+            drumPads[i].skipBlock(buffer.getNumSamples());
+        }
     }
     
     // Clear the main output buffer
@@ -406,9 +465,20 @@ void DrumMachineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     {
         audioVisualizer->pushBuffer(buffer);
     }
+    
+    // Tell the UI which pads are sounding
+    journalPadStates(buffer.getNumSamples());
+    
+    // Send the note events of the cells instead of the incoming MIDI. They are copied rather than
+    // swapped in, so midiOutput keeps its reserved capacity for the next block.
+    midiMessages.clear();
+    midiMessages.addEvents(midiOutput, 0, -1, 0);
+    
+    // Advance the sample clock to the start of the next block
+    sampleClock += buffer.getNumSamples();
 }
 
-void DrumMachineAudioProcessor::processMidiMessages(juce::MidiBuffer& midiMessages)
+void DrumMachineAudioProcessor::processMidiMessages(juce::MidiBuffer& midiMessages, int numSamples)
 {
     for (const auto metadata : midiMessages)
     {
@@ -432,14 +502,13 @@ void DrumMachineAudioProcessor::processMidiMessages(juce::MidiBuffer& midiMessag
                 " (Pitch shift from middle C: " + juce::String(noteNumber - MIDDLE_C) + ")");
             
             // If this is the first note, initialize the Game of Life grid
-            // and set the lastGameOfLifeUpdateTime to current time
+            // and start the free-running interval from the note
             if (wasEmpty)
             {
-                // Always use system time to ensure updates happen regardless of host play state
-                lastGameOfLifeUpdateTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+                lastGenerationSample = static_cast<double>(sampleClock + metadata.samplePosition);
                 
-                // Process samples based on the current grid state
-                processGameOfLife();
+                // Process samples based on the current grid state, from the note's position in the block
+                processGameOfLife(metadata.samplePosition);
             }
         }
         else if (message.isNoteOff())
@@ -452,6 +521,10 @@ void DrumMachineAudioProcessor::processMidiMessages(juce::MidiBuffer& midiMessag
             // If there are no more active notes, stop all samples
             if (activeNotes.empty())
             {
+                // End the notes sent to the MIDI output whatever the timing mode: the grid stops
+                // stepping, so no cell death would end them later
+                sendAllCellNotesOff(metadata.samplePosition);
+                
                 // Only stop samples if we're not in timing control mode
                 // In timing control mode, let the grid pattern control when samples stop
                 bool timingControlEnabled = false;
@@ -474,163 +547,419 @@ void DrumMachineAudioProcessor::processMidiMessages(juce::MidiBuffer& midiMessag
                         drumPad.stopSample();
                     }
                     
-                    // Also mark all scheduled samples as inactive
-                    for (auto& scheduledSample : scheduledSamples)
-                    {
-                        scheduledSample.active = false;
-                        DebugLogger::log("Marking scheduled sample as inactive");
-                    }
-                    
-                    DebugLogger::log("MIDI Note Off: All notes released, marked all scheduled samples as inactive");
-                }
-                else
-                {
-                    DebugLogger::log("MIDI Note Off: All notes released, but samples continue in timing control mode");
+                    // Also drop all scheduled samples
+                    scheduledSamples.clear();
                 }
             }
         }
         else if (message.isMidiClock())
         {
             // Handle MIDI clock messages
-            processMidiClock();
+            processMidiClock(metadata.samplePosition, numSamples);
+        }
+        else if (message.isMidiStart())
+        {
+            midiClock.handleStart();
+        }
+        else if (message.isMidiContinue())
+        {
+            midiClock.handleContinue();
+        }
+        else if (message.isMidiStop())
+        {
+            midiClock.handleStop();
+        }
+        else if (message.isSongPositionPointer())
+        {
+            midiClock.handleSongPosition(message.getSongPositionPointerMidiBeat());
         }
     }
 }
 
-void DrumMachineAudioProcessor::processGameOfLife()
+void DrumMachineAudioProcessor::advanceGeneration(int sampleOffset)
 {
-    // Process each cell in the grid
-    for (int i = 0; i < ParameterManager::GRID_SIZE; ++i)
+    // Scheduled samples due before the generation play first, so the generation's deaths
+    // release them rather than cancel them
+    processScheduledSamples(sampleClock + sampleOffset);
+    
+    // Update the Game of Life
+    gameOfLife->update();
+    ++generationCount;
+    
+    // Remember where this generation happened
+    lastGenerationSample = static_cast<double>(sampleClock + sampleOffset);
+    
+    // Process samples based on the updated grid state
+    processGameOfLife(sampleOffset);
+    
+    // Start a new pattern if this one has died out or settled
+    reseedIfSettled();
+    endRemovedCells(sampleOffset);
+}
+
+void DrumMachineAudioProcessor::advanceGenerationsWithHost(const juce::AudioPlayHead::CurrentPositionInfo& posInfo,
+                                                           int intervalInTicks, int numSamples)
+{
+    // Interval in quarter notes (960 ticks per quarter note), and the block's span of the timeline
+    const double intervalPpq = juce::jmax(1, intervalInTicks) / 960.0;
+    const double samplesPerPpq = getSampleRate() * 60.0 / posInfo.bpm;
+    const double blockStartPpq = posInfo.ppqPosition;
+    const double blockEndPpq = blockStartPpq + numSamples / samplesPerPpq;
+    
+    // Hosts report block starts that can be a rounding step off the previous block's end, so a
+    // boundary on the block edge could be run twice or skipped. While the transport plays on
+    // without a jump, carry on from the boundary after the last one run instead; after a jump,
+    // a loop or an interval change, start from the first boundary in the block.
+    const bool continuous = hostBoundaryValid
+                         && intervalPpq == lastHostIntervalPpq
+                         && std::abs(blockStartPpq - expectedHostPpq) * samplesPerPpq <= HOST_JUMP_TOLERANCE_SAMPLES;
+    
+    int64_t boundaryIndex = continuous ? lastHostBoundary + 1
+                                       : static_cast<int64_t>(std::ceil(blockStartPpq / intervalPpq));
+    
+    // Every remaining boundary before the end of the block is a generation (one a rounding step
+    // before the block start runs at its first sample)
+    for (; boundaryIndex * intervalPpq < blockEndPpq; ++boundaryIndex)
     {
-        for (int j = 0; j < ParameterManager::GRID_SIZE; ++j)
+        const double boundary = boundaryIndex * intervalPpq;
+        const int sampleOffset = juce::jlimit(0, numSamples - 1,
+                                              static_cast<int>((boundary - blockStartPpq) * samplesPerPpq));
+        advanceGeneration(sampleOffset);
+    }
+    
+    lastHostBoundary = boundaryIndex - 1;
+    expectedHostPpq = blockEndPpq;
+    lastHostIntervalPpq = intervalPpq;
+    hostBoundaryValid = true;
+}
+
+void DrumMachineAudioProcessor::advanceGenerationsFreeRunning(double bpm, int intervalInTicks, int numSamples)
+{
+    // Convert MIDI ticks to samples
+    // MIDI clock sends 24 ticks per quarter note (24 PPQN)
+    // But our intervalInTicks is calculated based on 960 PPQN (JUCE standard)
+    const double samplesPerBeat = getSampleRate() * 60.0 / bpm;
+    const double intervalSamples = juce::jmax(1.0, samplesPerBeat * (juce::jmax(1, intervalInTicks) / 960.0));
+    const double blockStart = static_cast<double>(sampleClock);
+    const double blockEnd = blockStart + numSamples;
+    
+    // A generation that is already overdue (after a tempo change, or if the interval started
+    // before the block) runs at the start of the block, and the next interval counts from there
+    for (double due = lastGenerationSample + intervalSamples; due < blockEnd;
+         due = lastGenerationSample + intervalSamples)
+    {
+        const double position = juce::jmax(due, blockStart);
+        const int sampleOffset = juce::jlimit(0, numSamples - 1, static_cast<int>(std::ceil(position - blockStart)));
+        advanceGeneration(sampleOffset);
+        lastGenerationSample = position;
+    }
+}
+
+void DrumMachineAudioProcessor::processGameOfLife(int sampleOffset)
+{
+    using CellEvent = GameOfLifeApp::CellEvent;
+    
+    const CellEvent* events = gameOfLife->getEvents();
+    const int numEvents = gameOfLife->getNumEvents();
+    
+    // Group the events by pad (a counting sort, keeping each pad's events in row order).
+    // Only cells that were born, died or stayed alive in the last generation can trigger.
+    std::array<int, ParameterManager::NUM_SAMPLES> padCounts {};
+    
+    // Births and deaths of the cells on pads, for the journal
+    JournalEvent generationEvent;
+    generationEvent.type = JournalEvent::Type::Generation;
+    generationEvent.generation = generationCount;
+    
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const int pad = triggerPlan->getPadForColumn(events[i].x);
+        if (pad < 0)
+            continue;
+        
+        ++padCounts[static_cast<size_t>(pad)];
+        
+        if (events[i].type == CellEvent::Type::Birth)
         {
-            // In the grid display, i is the row and j is the column
-            // So we need to use the correct mapping for visual representation
-            int row = j;    // y in the visual grid
-            int column = i; // x in the visual grid
-            
-            // Get the current state of this cell
-            bool currentState = gameOfLife->getCellState(i, j);
-            
-            // Map column directly to sample index
-            int sampleIndex = column % ParameterManager::NUM_SAMPLES;
-            
-            // Skip if the sample is muted
-            if (parameterManager->getMuteForSample(sampleIndex))
-                continue;
-            
-            // Calculate velocity based on row position (higher rows = higher velocity)
-            float velocity = 0.5f + (static_cast<float>(row) / static_cast<float>(ParameterManager::GRID_SIZE)) * 0.5f;
-            
-            // Calculate pitch shift if needed
-            int totalPitchShift = 0;
+            ++generationEvent.count;
+            generationEvent.birthPads |= static_cast<uint16_t>(1u << pad);
+        }
+        else if (events[i].type == CellEvent::Type::Death)
+        {
+            ++generationEvent.deaths;
+            generationEvent.deathPads |= static_cast<uint16_t>(1u << pad);
+        }
+    }
+    
+    eventJournal.push(generationEvent);
+    
+    padEventStarts[0] = 0;
+    for (int pad = 0; pad < ParameterManager::NUM_SAMPLES; ++pad)
+        padEventStarts[static_cast<size_t>(pad + 1)] = padEventStarts[static_cast<size_t>(pad)] + padCounts[static_cast<size_t>(pad)];
+    
+    std::array<int, ParameterManager::NUM_SAMPLES> padPositions {};
+    std::copy(padEventStarts.begin(), padEventStarts.end() - 1, padPositions.begin());
+    
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const int pad = triggerPlan->getPadForColumn(events[i].x);
+        if (pad >= 0)
+            padEvents[static_cast<size_t>(padPositions[static_cast<size_t>(pad)]++)] = events[i];
+    }
+    
+    // Pitch shift of pads following the MIDI note
+    const int midiPitchShift = mostRecentMidiNote - MIDDLE_C;
+    
+    // Run each pad's events through the kernel for its mode, chosen once per generation
+    for (int pad = 0; pad < ParameterManager::NUM_SAMPLES; ++pad)
+    {
+        const int start = padEventStarts[static_cast<size_t>(pad)];
+        const int count = padEventStarts[static_cast<size_t>(pad + 1)] - start;
+        
+        if (count == 0)
+            continue;
+        
+        const TriggerKernel kernel = triggerKernels[triggerPlan->getPadFlags(pad) & TriggerPlan::PAD_MODE_FLAGS];
+        (this->*kernel)(pad, padEvents.data() + start, count, midiPitchShift, sampleOffset);
+    }
+}
+
+template <bool MidiPitch, bool Legato, bool Timing>
+void DrumMachineAudioProcessor::triggerPadEvents(int padIndex, const GameOfLifeApp::CellEvent* events,
+                                                 int numEvents, int midiPitchShift, int sampleOffset)
+{
+    using CellEvent = GameOfLifeApp::CellEvent;
+    
+    DrumPad& drumPad = drumPads[padIndex];
+    int numTriggers = 0;
+    
+    // Summary of the immediate triggers, for the journal
+    JournalEvent triggerEvent;
+    triggerEvent.type = JournalEvent::Type::Trigger;
+    triggerEvent.pad = static_cast<uint8_t>(padIndex);
+    triggerEvent.generation = generationCount;
+    
+    // Where the pad's events go; checked once per generation, not per cell
+    const uint8_t flags = triggerPlan->getPadFlags(padIndex);
+    const bool toSampler = (flags & TriggerPlan::SAMPLER) != 0;
+    const bool toMidi = (flags & TriggerPlan::MIDI_OUT) != 0;
+    
+    for (int i = 0; i < numEvents; ++i)
+    {
+        const CellEvent& event = events[i];
+        
+        int row = event.y;    // y in the visual grid
+        int column = event.x; // x in the visual grid
+        
+        // Check if cell just deactivated (went from on to off)
+        if (event.type == CellEvent::Type::Death)
+        {
+            // Cell just turned off - stop sample with release for this specific cell
+            drumPad.stopSampleForCell(column, row, sampleOffset);
             
-            // Get the MIDI pitch and row pitch settings for this sample
-            bool midiPitchEnabled = parameterManager->getMidiPitchParam(sampleIndex)->get();
-            bool rowPitchEnabled = parameterManager->getRowPitchParam(sampleIndex)->get();
+            // End its MIDI note, if it has one (even if the pad no longer sends MIDI)
+            sendCellNoteOff(column, row, sampleOffset);
             
-            // Calculate MIDI-based pitch shift if enabled
-            if (midiPitchEnabled)
-            {
-                // Calculate pitch shift based on MIDI note
-                int basePitchShift = mostRecentMidiNote - MIDDLE_C;
-                totalPitchShift += basePitchShift;
-                
-                // Debug output to verify MIDI pitch is being applied
-                DebugLogger::log("MIDI Pitch enabled for sample " + std::to_string(sampleIndex) + 
-                                ", MIDI Note: " + std::to_string(mostRecentMidiNote) + 
-                                ", Base Pitch Shift: " + std::to_string(basePitchShift));
-            }
+            // Also cancel any scheduled samples for this cell
+            scheduledSamples.cancelCell(column, row);
             
-            // Add row-based pitch offset if enabled
-            if (rowPitchEnabled)
+            continue;
+        }
+        
+        // A surviving cell in legato mode keeps playing its sample
+        if (Legato && event.type == CellEvent::Type::Survive)
+            continue;
+        
+        // Births, and survivals that retrigger, play the sample from the beginning
+        const TriggerPlan::Entry& plan = triggerPlan->getEntry(row, padIndex);
+        const int pitchShift = MidiPitch ? plan.pitchShift + midiPitchShift : plan.pitchShift;
+        
+        // Generations the cell has been alive, for age modulation
+        const int cellAge = gameOfLife->getCellAge(column, row);
+        
+        if (Timing && plan.delayMs > 0.0f)
+        {
+            // If timing delay is active, schedule the sample to be triggered with a delay
+            // (counted from the generation's position in the block)
+            scheduleSampleWithDelay(padIndex, plan.velocity, pitchShift, column, row, plan.delayMs, cellAge, sampleOffset);
+        }
+        else
+        {
+            // Trigger immediately with appropriate pitch shift (with the pad's other triggers)
+            if (toSampler)
             {
-                // Add row-based pitch offset using the selected scale
-                int rowPitchOffset = parameterManager->getPitchOffsetForRow(row);
-                totalPitchShift += rowPitchOffset;
-                
-                // Debug output to verify row pitch is being applied
-                DebugLogger::log("Row Pitch enabled for sample " + std::to_string(sampleIndex) + 
-                                ", Row: " + std::to_string(row) + 
-                                ", Row Pitch Offset: " + std::to_string(rowPitchOffset));
+                TriggerEvent& trigger = padTriggers[static_cast<size_t>(numTriggers++)];
+                trigger.velocity = plan.velocity;
+                trigger.pitchShiftSemitones = pitchShift;
+                trigger.cellX = column;
+                trigger.cellY = row;
+                trigger.cellAge = cellAge;
+                trigger.sampleOffset = sampleOffset;
             }
             
-            // Get the control mode for this column
-            auto controlMode = parameterManager->getControlModeForColumn(column);
+            if (toMidi)
+                sendCellNoteOn(padIndex, column, row, plan.velocity, pitchShift, sampleOffset);
             
-            // Calculate timing delay if needed
-            float delayMs = 0.0f;
-            if (controlMode == ColumnControlMode::Timing || controlMode == ColumnControlMode::Both)
-            {
-                // Get row-based timing delay (0-160ms)
-                delayMs = parameterManager->getTimingDelayForRow(row);
-            }
+            ++triggerEvent.count;
+            triggerEvent.note = static_cast<int16_t>(triggerPlan->getPadMidiNote(padIndex) + pitchShift);
+            triggerEvent.value = plan.velocity;
+        }
+    }
+    
+    if (triggerEvent.count > 0)
+        eventJournal.push(triggerEvent);
+    
+    // Start the voices of the whole generation at once
+    if (numTriggers > 0)
+        drumPad.triggerBatch(padTriggers.data(), numTriggers);
+}
+
+void DrumMachineAudioProcessor::sendCellNoteOn(int padIndex, int column, int row, float velocity,
+                                               int pitchShift, int sampleOffset)
+{
+    // A retriggered cell ends its previous note first
+    sendCellNoteOff(column, row, sampleOffset);
+    
+    const int channel = triggerPlan->getPadMidiChannel(padIndex);
+    const int note = juce::jlimit(0, 127, triggerPlan->getPadMidiNote(padIndex) + pitchShift);
+    
+    midiOutput.addEvent(juce::MidiMessage::noteOn(channel, note, velocity), sampleOffset);
+    cellMidiNotes[static_cast<size_t>(row * ParameterManager::MAX_GRID_SIZE + column)] = (channel - 1) * 128 + note;
+}
+
+void DrumMachineAudioProcessor::sendCellNoteOff(int column, int row, int sampleOffset)
+{
+    int& sounding = cellMidiNotes[static_cast<size_t>(row * ParameterManager::MAX_GRID_SIZE + column)];
+    
+    if (sounding < 0)
+        return;
+    
+    midiOutput.addEvent(juce::MidiMessage::noteOff(sounding / 128 + 1, sounding % 128), sampleOffset);
+    sounding = -1;
+}
+
+void DrumMachineAudioProcessor::journalPadStates(int numSamples)
+{
+    samplesSinceJournaledLevels += numSamples;
+    const bool levelsDue = samplesSinceJournaledLevels >= getSampleRate() * JOURNAL_LEVEL_INTERVAL_MS / 1000.0;
+    
+    if (levelsDue)
+        samplesSinceJournaledLevels = 0;
+    
+    for (int i = 0; i < ParameterManager::NUM_SAMPLES; ++i)
+    {
+        const int voices = drumPads[i].getNumActiveVoices();
+        auto& journaled = journaledVoiceCounts[static_cast<size_t>(i)];
+        
+        if (voices == journaled && ! (levelsDue && voices > 0))
+            continue;
+        
+        JournalEvent padEvent;
+        padEvent.type = JournalEvent::Type::PadState;
+        padEvent.pad = static_cast<uint8_t>(i);
+        padEvent.count = voices;
+        padEvent.value = drumPads[i].getCurrentVolumeLevel();
+        padEvent.generation = generationCount;
+        
+        // Only remember the count if it reached the UI, so a full ring is caught up later
+        if (eventJournal.push(padEvent))
+            journaled = voices;
+    }
+}
+
+void DrumMachineAudioProcessor::sendAllCellNotesOff(int sampleOffset)
+{
+    for (int& sounding : cellMidiNotes)
+    {
+        if (sounding >= 0)
+        {
+            midiOutput.addEvent(juce::MidiMessage::noteOff(sounding / 128 + 1, sounding % 128), sampleOffset);
+            sounding = -1;
+        }
+    }
+}
+
+void DrumMachineAudioProcessor::endRemovedCells(int sampleOffset)
+{
+    if (! gameOfLife->takeOutsideEdit())
+        return;
+    
+    const int width = gameOfLife->getWidth();
+    const int height = gameOfLife->getHeight();
+    
+    // Whether a cell is alive in the edited grid (cells beyond a shrunk grid are not)
+    auto isAlive = [&](int column, int row)
+    {
+        return column < width && row < height && gameOfLife->getCellState(column, row);
+    };
+    
+    // MIDI notes and delayed triggers, kept for every cell of the largest grid
+    for (int row = 0; row < ParameterManager::MAX_GRID_SIZE; ++row)
+    {
+        for (int column = 0; column < ParameterManager::MAX_GRID_SIZE; ++column)
+        {
+            if (isAlive(column, row))
+                continue;
             
-            // If velocity mode is not active, use a fixed velocity
-            if (controlMode != ColumnControlMode::Velocity && controlMode != ColumnControlMode::Both)
-            {
-                velocity = 0.8f; // Use a fixed velocity when not in velocity mode
-            }
+            sendCellNoteOff(column, row, sampleOffset);
+            scheduledSamples.cancelCell(column, row);
+        }
+    }
+    
+    // Sampler voices started by cells
+    for (int pad = 0; pad < ParameterManager::NUM_SAMPLES; ++pad)
+    {
+        for (int i = 0; i < voicePool.getNumVoices(pad); ++i)
+        {
+            const int voice = voicePool.getVoice(pad, i);
+            const int column = voicePool.cellXs[static_cast<size_t>(voice)];
+            const int row = voicePool.cellYs[static_cast<size_t>(voice)];
             
-            // Check if cell just activated (went from off to on)
-            if (gameOfLife->cellJustActivated(i, j))
-            {
-                // Cell just turned on - trigger sample from beginning
-                if (delayMs > 0.0f)
-                {
-                    // If timing delay is active, schedule the sample to be triggered with a delay
-                    scheduleSampleWithDelay(sampleIndex, velocity, totalPitchShift, column, row, delayMs);
-                }
-                else
-                {
-                    // Trigger immediately with appropriate pitch shift
-                    drumPads[sampleIndex].triggerSampleUnified(velocity, totalPitchShift, column, row);
-                }
-            }
-            else if (currentState && gameOfLife->wasCellActive(i, j))
-            {
-                // Cell remains on
-                bool isLegato = parameterManager->getLegatoForSample(sampleIndex);
-                
-                if (!isLegato)
-                {
-                    // Not legato - retrigger sample from beginning
-                    if (delayMs > 0.0f)
-                    {
-                        // If timing delay is active, schedule the sample to be triggered with a delay
-                        scheduleSampleWithDelay(sampleIndex, velocity, totalPitchShift, column, row, delayMs);
-                    }
-                    else
-                    {
-                        // Trigger immediately with appropriate pitch shift
-                        drumPads[sampleIndex].triggerSampleUnified(velocity, totalPitchShift, column, row);
-                    }
-                }
-                // If legato, continue playing the sample (do nothing)
-            }
-            // Check if cell just deactivated (went from on to off)
-            else if (gameOfLife->cellJustDeactivated(i, j))
-            {
-                // Cell just turned off - stop sample with release for this specific cell
-                drumPads[sampleIndex].stopSampleForCell(column, row);
-                
-                // Also mark any scheduled samples for this cell as inactive
-                for (auto& scheduledSample : scheduledSamples)
-                {
-                    if (scheduledSample.sampleIndex == sampleIndex && 
-                        scheduledSample.cellX == column && 
-                        scheduledSample.cellY == row)
-                    {
-                        scheduledSample.active = false;
-                        DebugLogger::log("Marking scheduled sample as inactive for cell (" + 
-                                        std::to_string(column) + "," + std::to_string(row) + ")");
-                    }
-                }
-            }
+            if (column >= 0 && row >= 0 && ! isAlive(column, row))
+                drumPads[pad].stopSampleForCell(column, row, sampleOffset);
         }
     }
 }
 
+// Indexed by the TriggerPlan pad mode flags
+static_assert(TriggerPlan::MIDI_PITCH == 1 && TriggerPlan::LEGATO == 2 && TriggerPlan::TIMING == 4,
+              "Trigger kernels are listed in flag order");
+
+const DrumMachineAudioProcessor::TriggerKernel DrumMachineAudioProcessor::triggerKernels[TriggerPlan::NUM_PAD_MODES] =
+{
+    &DrumMachineAudioProcessor::triggerPadEvents<false, false, false>,
+    &DrumMachineAudioProcessor::triggerPadEvents<true,  false, false>,
+    &DrumMachineAudioProcessor::triggerPadEvents<false, true,  false>,
+    &DrumMachineAudioProcessor::triggerPadEvents<true,  true,  false>,
+    &DrumMachineAudioProcessor::triggerPadEvents<false, false, true>,
+    &DrumMachineAudioProcessor::triggerPadEvents<true,  false, true>,
+    &DrumMachineAudioProcessor::triggerPadEvents<false, true,  true>,
+    &DrumMachineAudioProcessor::triggerPadEvents<true,  true,  true>
+};
+
+void DrumMachineAudioProcessor::reseedIfSettled()
+{
+    AutoReseed mode = parameterManager->getAutoReseed();
+    if (mode == AutoReseed::Off)
+        return;
+    
+    CycleState state = gameOfLife->getCycleState();
+    
+    bool settled = (state == CycleState::Extinct || state == CycleState::Static)
+                || (mode == AutoReseed::WhenCycling && state == CycleState::Oscillating);
+    
+    if (!settled)
+        return;
+    
+    // Reseed with the density of the section being played
+    float density = 0.5f;
+    auto* densityParam = parameterManager->getSectionDensityParam(parameterManager->getActiveSection());
+    if (densityParam != nullptr)
+        density = densityParam->get();
+    
+    gameOfLife->initializeWithDensity(density);
+}
+
 //==============================================================================
 bool DrumMachineAudioProcessor::hasEditor() const
 {
@@ -685,6 +1014,8 @@ void DrumMachineAudioProcessor::setStateInformation (const void* data, int sizeI
         if (paramsXml != nullptr && paramsXml->hasTagName(parameterManager->getAPVTS().state.getType()))
         {
             parameterManager->getAPVTS().replaceState(juce::ValueTree::fromXml(*paramsXml));
+            parameterManager->restoreColumnPadMapFromState();
+            parameterManager->restoreCustomRuleFromState();
         }
         
         // Restore sample paths
@@ -771,10 +1102,24 @@ void DrumMachineAudioProcessor::triggerSampleWithPitch(int padIndex, float veloc
     }
 }
 
-void DrumMachineAudioProcessor::processMidiClock()
+void DrumMachineAudioProcessor::processMidiClock(int samplePosition, int numSamples)
 {
-    // Increment clock counter
-    midiClockCounter++;
+    // Follow the clock whatever the clock source, so its tempo is known when it is selected
+    midiClock.handleTick(sampleClock + samplePosition);
+    
+    if (parameterManager->getClockSource() != ClockSource::MidiClock
+        || ! midiClock.isRunning() || ! midiClock.isLocked() || ! isAnyNoteActive())
+        return;
+    
+    // Our intervals are in 960 PPQN ticks; every interval is a whole number of 24 PPQN clock ticks
+    const int ticksPerGeneration = juce::jmax(1, calculateIntervalInTicks() * MidiClockSync::TICKS_PER_QUARTER_NOTE / 960);
+    
+    if (midiClock.getTickCount() % ticksPerGeneration == 0)
+    {
+        // Step at the smoothed position of the tick rather than at its jittery timestamp
+        const double tickOffset = midiClock.getTickPosition() - static_cast<double>(sampleClock);
+        advanceGeneration(juce::jlimit(0, numSamples - 1, juce::roundToInt(tickOffset)));
+    }
 }
 
 int DrumMachineAudioProcessor::calculateIntervalInTicks()
@@ -863,46 +1208,61 @@ juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 }
 
 void DrumMachineAudioProcessor::scheduleSampleWithDelay(int sampleIndex, float velocity, int pitchShift, 
-                                                      int cellX, int cellY, float delayMs)
+                                                      int cellX, int cellY, float delayMs, int cellAge, int sampleOffset)
 {
-    // Calculate the trigger time based on current time plus delay
-    double currentTime = juce::Time::getMillisecondCounterHiRes() / 1000.0;
-    double triggerTime = currentTime + (delayMs / 1000.0); // Convert ms to seconds
+    // Calculate the trigger position on the sample clock from the generation's position plus delay
+    const int delaySamples = juce::roundToInt(delayMs * getSampleRate() / 1000.0); // Convert ms to samples
     
-    // Create a scheduled sample and add it to the queue
-    scheduledSamples.emplace_back(sampleIndex, velocity, pitchShift, cellX, cellY, triggerTime);
+    // Create a scheduled sample and add it to the queue (dropped if the queue is full)
+    TriggerScheduler::ScheduledTrigger trigger;
+    trigger.triggerSample = sampleClock + sampleOffset + delaySamples;
+    trigger.sampleIndex = sampleIndex;
+    trigger.velocity = velocity;
+    trigger.pitchShift = pitchShift;
+    trigger.cellX = cellX;
+    trigger.cellY = cellY;
+    trigger.cellAge = cellAge;
+    
+    scheduledSamples.schedule(trigger);
 }
 
-void DrumMachineAudioProcessor::processScheduledSamples(double currentTime)
+void DrumMachineAudioProcessor::processScheduledSamples(int64_t endSample)
 {
-    // Process any scheduled samples that are due to be triggered
-    auto it = scheduledSamples.begin();
-    while (it != scheduledSamples.end())
+    // Process the scheduled samples that are due, earliest first (cancelled ones are never returned)
+    TriggerScheduler::ScheduledTrigger trigger;
+    
+    while (scheduledSamples.popDue(endSample - 1, trigger))
     {
-        if (currentTime >= it->triggerTime)
+        const uint8_t flags = triggerPlan->getPadFlags(trigger.sampleIndex);
+        
+        // Where the trigger falls in this block
+        const int sampleOffset = static_cast<int>(juce::jmax<int64_t>(0, trigger.triggerSample - sampleClock));
+        
+        // Start the sample at its offset, so the delay is not rounded to a block boundary
+        if (flags & TriggerPlan::SAMPLER)
         {
-            // Only trigger if the sample is still active (cell hasn't been turned off)
-            if (it->active)
-            {
-                // Time to trigger this sample using the unified function
-                drumPads[it->sampleIndex].triggerSampleUnified(it->velocity, it->pitchShift, it->cellX, it->cellY);
-                DebugLogger::log("Triggering scheduled sample for cell (" + 
-                                std::to_string(it->cellX) + "," + std::to_string(it->cellY) + ")");
-            }
-            else
-            {
-                DebugLogger::log("Skipping inactive scheduled sample for cell (" + 
-                                std::to_string(it->cellX) + "," + std::to_string(it->cellY) + ")");
-            }
+            TriggerEvent event;
+            event.velocity = trigger.velocity;
+            event.pitchShiftSemitones = trigger.pitchShift;
+            event.cellX = trigger.cellX;
+            event.cellY = trigger.cellY;
+            event.cellAge = trigger.cellAge;
+            event.sampleOffset = sampleOffset;
             
-            // Remove this sample from the queue
-            it = scheduledSamples.erase(it);
-        }
-        else
-        {
-            // Not yet time to trigger this sample
-            ++it;
+            drumPads[trigger.sampleIndex].triggerBatch(&event, 1);
         }
+        
+        if (flags & TriggerPlan::MIDI_OUT)
+            sendCellNoteOn(trigger.sampleIndex, trigger.cellX, trigger.cellY, trigger.velocity, trigger.pitchShift, sampleOffset);
+        
+        JournalEvent triggerEvent;
+        triggerEvent.type = JournalEvent::Type::Trigger;
+        triggerEvent.pad = static_cast<uint8_t>(trigger.sampleIndex);
+        triggerEvent.note = static_cast<int16_t>(triggerPlan->getPadMidiNote(trigger.sampleIndex) + trigger.pitchShift);
+        triggerEvent.value = trigger.velocity;
+        triggerEvent.count = 1;
+        triggerEvent.generation = generationCount;
+        eventJournal.push(triggerEvent);
     }
 }
 
@@ -2,9 +2,14 @@
 
 #include <JuceHeader.h>
 #include "DrumPad.h"
+#include "EventJournal.h"
 #include "GameOfLife.h"
+#include "MidiClockSync.h"
 #include "ParameterManager.h"
+#include "TriggerPlan.h"
+#include "TriggerScheduler.h"
 #include "UI/NoteActivityIndicator.h"
+#include "VoicePool.h"
 
 //==============================================================================
 /**
@@ -58,14 +63,32 @@ public:
     // Trigger a sample with pitch shift
     void triggerSampleWithPitch(int padIndex, float velocity, int pitchShiftSemitones);
     
-    // Process MIDI clock
-    void processMidiClock();
+    // Process a MIDI clock tick samplePosition samples into the block, stepping the Game of Life
+    // when the MIDI clock is the clock source
+    void processMidiClock(int samplePosition, int numSamples);
     
     // Process MIDI messages
-    void processMidiMessages(juce::MidiBuffer& midiMessages);
+    void processMidiMessages(juce::MidiBuffer& midiMessages, int numSamples);
     
-    // Process Game of Life
-    void processGameOfLife();
+    // Process Game of Life (trigger the cells of the current generation sampleOffset samples
+    // into the block)
+    void processGameOfLife(int sampleOffset = 0);
+    
+    // Move the Game of Life to its next generation sampleOffset samples into the block, and
+    // trigger its cells there
+    void advanceGeneration(int sampleOffset);
+    
+    // Run the generations whose interval boundaries fall inside this block, each at the sample
+    // where the host position crosses the boundary
+    void advanceGenerationsWithHost(const juce::AudioPlayHead::CurrentPositionInfo& posInfo,
+                                    int intervalInTicks, int numSamples);
+    
+    // Run the generations due in this block when the transport is stopped, one interval at the
+    // given tempo after the last generation
+    void advanceGenerationsFreeRunning(double bpm, int intervalInTicks, int numSamples);
+    
+    // Reseed the grid if it has settled and automatic reseeding is enabled
+    void reseedIfSettled();
     
     // Check if any MIDI note is active
     bool isAnyNoteActive() const { return !activeNotes.empty(); }
@@ -82,6 +105,9 @@ public:
     // Get the visualization buffer
     juce::AudioBuffer<float>& getVisualizationBuffer() { return visualizationBuffer; }
     
+    // Generations, triggers and pad states pushed by the audio thread; drained by the editor
+    EventJournal& getEventJournal() { return eventJournal; }
+    
     // Get the waveform buffer for visualization
     juce::AudioBuffer<float> getWaveformBuffer() 
     { 
@@ -145,40 +171,101 @@ private:
     // Game of Life
     std::unique_ptr<GameOfLife> gameOfLife;
     
-    // Scheduled sample data structure
-    struct ScheduledSample
-    {
-        int sampleIndex;
-        float velocity;
-        int pitchShift;
-        int cellX;
-        int cellY;
-        double triggerTime;
-        bool active;
-        
-        ScheduledSample(int index, float vel, int pitch, int x, int y, double time)
-            : sampleIndex(index), velocity(vel), pitchShift(pitch), 
-              cellX(x), cellY(y), triggerTime(time), active(true) {}
-    };
+    // How each cell triggers its pad, rebuilt when the parameters change
+    std::unique_ptr<TriggerPlan> triggerPlan;
+    
+    // The events of the last generation grouped by pad (preallocated for the largest grid);
+    // the events of pad i are padEvents[padEventStarts[i]] to padEvents[padEventStarts[i + 1] - 1]
+    std::vector<GameOfLifeApp::CellEvent> padEvents;
+    std::array<int, ParameterManager::NUM_SAMPLES + 1> padEventStarts {};
+    
+    // Immediate triggers of the pad being processed, handed to the pad as one batch
+    std::vector<TriggerEvent> padTriggers;
+    
+    // Trigger and stop the samples of one pad for its events. The pad's mode flags are template
+    // parameters, so each combination is a separate kernel without per-cell mode checks.
+    template <bool MidiPitch, bool Legato, bool Timing>
+    void triggerPadEvents(int padIndex, const GameOfLifeApp::CellEvent* events, int numEvents,
+                          int midiPitchShift, int sampleOffset);
+    
+    // Write a cell's note-on to the MIDI output sampleOffset samples into the block, ending the
+    // note the cell was already playing
+    void sendCellNoteOn(int padIndex, int column, int row, float velocity, int pitchShift, int sampleOffset);
+    
+    // Write a note-off for the note a cell is playing on the MIDI output, if any
+    void sendCellNoteOff(int column, int row, int sampleOffset);
     
-    // Queue of samples scheduled to be triggered with delay
-    std::vector<ScheduledSample> scheduledSamples;
+    // Write note-offs for every note the cells are playing on the MIDI output
+    void sendAllCellNotesOff(int sampleOffset);
     
-    // Schedule a sample to be triggered with a delay
+    // After the grid has been changed from outside the automaton, end the notes, voices and
+    // scheduled triggers of cells it removed (they get no Death event)
+    void endRemovedCells(int sampleOffset);
+    
+    // Push a PadState event for each pad whose voice count changed, and for playing pads
+    // every JOURNAL_LEVEL_INTERVAL_MS
+    void journalPadStates(int numSamples);
+    
+    // Events for the UI, and what was last journaled for the pads
+    EventJournal eventJournal;
+    static constexpr double JOURNAL_LEVEL_INTERVAL_MS = 33.0;
+    std::array<int, ParameterManager::NUM_SAMPLES> journaledVoiceCounts {};
+    int samplesSinceJournaledLevels = 0;
+    
+    // Generations stepped since the plugin was created
+    uint64_t generationCount = 0;
+    
+    // Note events written during the block, sent in place of the incoming MIDI
+    juce::MidiBuffer midiOutput;
+    static const int MIDI_OUTPUT_RESERVED_BYTES = 16384;
+    
+    // Note each cell is playing on the MIDI output, as (channel - 1) * 128 + note (-1 = none),
+    // indexed by y * MAX_GRID_SIZE + x
+    std::vector<int> cellMidiNotes;
+    
+    // The kernel for each combination of TriggerPlan pad mode flags
+    using TriggerKernel = void (DrumMachineAudioProcessor::*)(int, const GameOfLifeApp::CellEvent*, int, int, int);
+    static const TriggerKernel triggerKernels[TriggerPlan::NUM_PAD_MODES];
+    
+    // Every pad's voices, allocated once
+    VoicePool voicePool;
+    
+    // Samples scheduled to be triggered with delay, ordered by their position on sampleClock
+    TriggerScheduler scheduledSamples;
+    
+    // Schedule a sample to be triggered delayMs after sampleOffset samples into the block
     void scheduleSampleWithDelay(int sampleIndex, float velocity, int pitchShift, 
-                                int cellX, int cellY, float delayMs);
+                                int cellX, int cellY, float delayMs, int cellAge = 0, int sampleOffset = 0);
+    
+    // Trigger the scheduled samples due before endSample on the sample clock, each at its own
+    // position in the current block (overdue ones at its start)
+    void processScheduledSamples(int64_t endSample);
+    
+    // External MIDI clock follower (tick count and smoothed tempo)
+    MidiClockSync midiClock;
+    
+    // Samples processed since prepareToPlay, at the start of the current block. Generations and
+    // delayed triggers are timed on this clock, so a render faster than real time matches playback.
+    int64_t sampleClock = 0;
     
-    // Process any scheduled samples that are due to be triggered
-    void processScheduledSamples(double currentTime);
+    // Position of the last generation on sampleClock (fractional, so free-running intervals
+    // do not drift)
+    double lastGenerationSample = 0.0;
     
-    // MIDI clock counter
-    int midiClockCounter = 0;
+    // Host-synced generations: index (on the interval grid) of the last boundary already run,
+    // and the position and interval the next block continues from if the transport has not
+    // jumped. Invalid while the host is not driving the generations.
+    int64_t lastHostBoundary = 0;
+    double expectedHostPpq = 0.0;
+    double lastHostIntervalPpq = 0.0;
+    bool hostBoundaryValid = false;
     
-    // MIDI clock enabled flag
-    bool midiClockEnabled = false;
+    // A host start position this close to the end of the previous block (a rounding step) is
+    // not a jump
+    static constexpr double HOST_JUMP_TOLERANCE_SAMPLES = 64.0;
     
-    // Game of Life last update time
-    double lastGameOfLifeUpdateTime = 0.0;
+    // Grid seed the random sequence was last restarted from (-1 to restart on the next block)
+    int lastGridSeed = -1;
     
     // Game of Life MIDI control state
     bool gameOfLifeEnabled = false;
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+
+namespace GameOfLifeApp {
+
+/**
+ * xoshiro256** pseudo-random generator.
+ *
+ * Each grid owns one, so the same seed always produces the same sequence of grids (unlike the
+ * shared juce::Random::getSystemRandom()), and whole words of cells are drawn at once.
+ */
+class RandomGenerator
+{
+public:
+    using Word = uint64_t;
+
+    explicit RandomGenerator(uint64_t seed = 1) { setSeed(seed); }
+
+    // Restart the sequence from a seed; any value (including 0) is a valid seed
+    void setSeed(uint64_t seed)
+    {
+        // Expand the seed into the 256-bit state with SplitMix64, which never yields all zeros
+        for (auto& word : state)
+        {
+            seed += 0x9e3779b97f4a7c15ULL;
+            uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    // Next 64 random bits
+    Word next()
+    {
+        const Word result = rotateLeft(state[1] * 5, 7) * 9;
+        const Word t = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotateLeft(state[3], 45);
+
+        return result;
+    }
+
+    // 64 random bits, each set with probability density (rounded to a multiple of 1/256).
+    // Each bit of the density, from the lowest, halves the probability so far and adds the bit:
+    // OR-ing with a random word gives (p + 1) / 2, AND-ing gives p / 2.
+    Word nextBits(float density)
+    {
+        const int level = juce::roundToInt(juce::jlimit(0.0f, 1.0f, density) * DENSITY_STEPS);
+
+        if (level == 0)
+            return 0;
+
+        if (level == DENSITY_STEPS)
+            return ~Word(0);
+
+        // Bits below the lowest set one would only AND zero with random words
+        int bit = 0;
+        while (((level >> bit) & 1) == 0)
+            ++bit;
+
+        Word bits = 0;
+        for (; bit < DENSITY_BITS; ++bit)
+            bits = ((level >> bit) & 1) ? (bits | next()) : (bits & next());
+
+        return bits;
+    }
+
+private:
+    static const int DENSITY_BITS = 8;
+    static const int DENSITY_STEPS = 1 << DENSITY_BITS;
+
+    static Word rotateLeft(Word x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    Word state[4] {};
+};
+
+} // namespace GameOfLifeApp
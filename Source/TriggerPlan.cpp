@@ -0,0 +1,115 @@
+#include "TriggerPlan.h"
+
+const char* const TriggerPlan::PAD_PARAMETER_PREFIXES[] =
+{
+    "mute_", "midi_pitch_", "row_pitch_", "velocity_mode_", "timing_mode_", "legato_",
+    "pad_output_mode_", "midi_note_", "midi_channel_"
+};
+
+const char* const TriggerPlan::GLOBAL_PARAMETER_IDS[] =
+{
+    "gridWidth", "gridHeight", "columnFolding", "musicalScale", "maxTimingDelay"
+};
+
+TriggerPlan::TriggerPlan(ParameterManager& pm)
+    : parameterManager(pm),
+      entries(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::NUM_SAMPLES))
+{
+    forEachParameterID([this](const juce::String& parameterID) {
+        parameterManager.getAPVTS().addParameterListener(parameterID, this);
+    });
+}
+
+TriggerPlan::~TriggerPlan()
+{
+    forEachParameterID([this](const juce::String& parameterID) {
+        parameterManager.getAPVTS().removeParameterListener(parameterID, this);
+    });
+}
+
+template <typename Callback>
+void TriggerPlan::forEachParameterID(Callback callback)
+{
+    for (int i = 0; i < ParameterManager::NUM_SAMPLES; ++i)
+        for (const char* prefix : PAD_PARAMETER_PREFIXES)
+            callback(prefix + juce::String(i));
+
+    for (const char* parameterID : GLOBAL_PARAMETER_IDS)
+        callback(juce::String(parameterID));
+}
+
+void TriggerPlan::parameterChanged(const juce::String& parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+    dirty = true;
+}
+
+void TriggerPlan::update()
+{
+    const int mapVersion = parameterManager.getColumnPadMapVersion();
+
+    if (dirty.exchange(false) || mapVersion != columnPadMapVersion)
+        rebuild();
+}
+
+void TriggerPlan::rebuild()
+{
+    const int gridWidth = parameterManager.getGridWidth();
+    const int gridHeight = parameterManager.getGridHeight();
+
+    // Take a consistent copy of the user column map; if it is being set right now, keep the
+    // last copy and take it again at the next update()
+    if (! parameterManager.copyColumnPadMap(columnPadMap, columnPadMapVersion))
+        columnPadMapVersion = -1;
+
+    // Fold the columns onto the pads, leaving out muted pads
+    for (int column = 0; column < ParameterManager::MAX_GRID_SIZE; ++column)
+    {
+        int pad = column < gridWidth ? parameterManager.getSampleForColumn(column, columnPadMap) : -1;
+
+        if (pad >= 0 && parameterManager.getMuteForSample(pad))
+            pad = -1;
+
+        columnPads[static_cast<size_t>(column)] = pad;
+    }
+
+    for (int pad = 0; pad < ParameterManager::NUM_SAMPLES; ++pad)
+    {
+        const int mode = static_cast<int>(parameterManager.getControlModeForSample(pad));
+        const bool velocityMode = (mode & static_cast<int>(ColumnControlMode::Velocity)) != 0;
+        const bool timingMode = (mode & static_cast<int>(ColumnControlMode::Timing)) != 0;
+        const bool rowPitch = parameterManager.getRowPitchParam(pad)->get();
+
+        uint8_t flags = 0;
+        if (parameterManager.getMidiPitchParam(pad)->get())
+            flags |= MIDI_PITCH;
+        if (parameterManager.getLegatoForSample(pad))
+            flags |= LEGATO;
+        if (timingMode)
+            flags |= TIMING;
+
+        const PadOutputMode outputMode = parameterManager.getPadOutputModeForSample(pad);
+        if (outputMode != PadOutputMode::Midi)
+            flags |= SAMPLER;
+        if (outputMode != PadOutputMode::Sampler)
+            flags |= MIDI_OUT;
+
+        padFlags[static_cast<size_t>(pad)] = flags;
+        padMidiNotes[static_cast<size_t>(pad)] = parameterManager.getMidiNoteForSample(pad);
+        padMidiChannels[static_cast<size_t>(pad)] = parameterManager.getMidiChannelForSample(pad);
+
+        for (int row = 0; row < gridHeight; ++row)
+        {
+            Entry& entry = entries[static_cast<size_t>(row * ParameterManager::NUM_SAMPLES + pad)];
+
+            // Higher rows play louder in velocity mode; otherwise a fixed velocity is used
+            entry.velocity = velocityMode ? 0.5f + (static_cast<float>(row) / static_cast<float>(gridHeight)) * 0.5f
+                                          : 0.8f;
+
+            entry.pitchShift = rowPitch ? parameterManager.getPitchOffsetForRow(row) : 0;
+
+            // Row-based timing delay (0 to the maximum delay)
+            entry.delayMs = timingMode ? parameterManager.getTimingDelayForRow(row) : 0.0f;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "ParameterManager.h"
+
+/**
+ * How each grid cell triggers its pad, precomputed from the parameters.
+ *
+ * Everything a cell event needs apart from the cell itself (its age) and the MIDI note being
+ * played is looked up here: the pad of each column, the mode flags of each pad, and for each
+ * row and pad the velocity, row pitch and timing delay. The tables are rebuilt on the audio
+ * thread only after a parameter listener (or a new column map) has marked them out of date, so
+ * the trigger pass does no parameter reads.
+ */
+class TriggerPlan : private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    // Mode flags of a pad
+    enum Flags : uint8_t
+    {
+        MIDI_PITCH = 1,   // add the MIDI note's pitch shift
+        LEGATO     = 2,   // surviving cells keep playing instead of retriggering
+        TIMING     = 4,   // rows are delayed by their entry's delayMs
+
+        // Flags that select a trigger kernel
+        PAD_MODE_FLAGS = MIDI_PITCH | LEGATO | TIMING,
+        NUM_PAD_MODES = PAD_MODE_FLAGS + 1,
+
+        // Where the pad's events go (see PadOutputMode)
+        SAMPLER    = 8,   // play the pad's internal voices
+        MIDI_OUT   = 16   // write note events to the MIDI output
+    };
+
+    // The trigger settings of one row of one pad
+    struct Entry
+    {
+        float velocity = 0.8f;
+        float delayMs = 0.0f;
+        int pitchShift = 0;     // row pitch in semitones (0 if row pitch is off)
+    };
+
+    explicit TriggerPlan(ParameterManager& pm);
+    ~TriggerPlan() override;
+
+    // Rebuild the tables if any of the settings they depend on have changed. Audio thread only.
+    void update();
+
+    // The pad a column triggers, or -1 if it has none or the pad is muted
+    int getPadForColumn(int column) const { return columnPads[static_cast<size_t>(column)]; }
+
+    // The mode flags shared by every row of a pad
+    uint8_t getPadFlags(int pad) const { return padFlags[static_cast<size_t>(pad)]; }
+
+    // MIDI output note (before pitch shifts) and channel (1-16) of a pad
+    int getPadMidiNote(int pad) const { return padMidiNotes[static_cast<size_t>(pad)]; }
+    int getPadMidiChannel(int pad) const { return padMidiChannels[static_cast<size_t>(pad)]; }
+
+    // The trigger settings of a row of a pad
+    const Entry& getEntry(int row, int pad) const
+    {
+        return entries[static_cast<size_t>(row * ParameterManager::NUM_SAMPLES + pad)];
+    }
+
+private:
+    // Parameters the tables depend on, per pad and global
+    static const char* const PAD_PARAMETER_PREFIXES[];
+    static const char* const GLOBAL_PARAMETER_IDS[];
+
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    // Recompute both tables from the current parameter values
+    void rebuild();
+
+    // Visit the IDs of every parameter the tables depend on
+    template <typename Callback>
+    static void forEachParameterID(Callback callback);
+
+    ParameterManager& parameterManager;
+
+    // Set by the parameter listener, cleared by update()
+    std::atomic<bool> dirty { true };
+    
+    // The user column map the tables were built from, and its version (-1 to copy it again)
+    ParameterManager::ColumnPadMap columnPadMap;
+    int columnPadMapVersion = -1;
+
+    std::array<int, ParameterManager::MAX_GRID_SIZE> columnPads {};
+    std::array<uint8_t, ParameterManager::NUM_SAMPLES> padFlags {};
+    std::array<int, ParameterManager::NUM_SAMPLES> padMidiNotes {};
+    std::array<int, ParameterManager::NUM_SAMPLES> padMidiChannels {};
+    std::vector<Entry> entries;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TriggerPlan)
+};
@@ -0,0 +1,167 @@
+#include "TriggerScheduler.h"
+#include <algorithm>
+
+TriggerScheduler::TriggerScheduler(int capacityToUse)
+    : capacity(juce::jmax(1, capacityToUse)),
+      slots(static_cast<size_t>(capacity)),
+      cellHeads(static_cast<size_t>(ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE))
+{
+    freeSlots.reserve(static_cast<size_t>(capacity));
+    heap.reserve(static_cast<size_t>(capacity));
+}
+
+int TriggerScheduler::getCellIndex(int cellX, int cellY)
+{
+    if (cellX < 0 || cellY < 0 || cellX >= ParameterManager::MAX_GRID_SIZE || cellY >= ParameterManager::MAX_GRID_SIZE)
+        return -1;
+
+    return cellY * ParameterManager::MAX_GRID_SIZE + cellX;
+}
+
+bool TriggerScheduler::isPending(Handle handle) const
+{
+    return handle.slot < slotsUsed
+        && slots[handle.slot].inUse
+        && slots[handle.slot].generation == handle.generation;
+}
+
+TriggerScheduler::Handle TriggerScheduler::schedule(const ScheduledTrigger& trigger)
+{
+    // Take a free slot, or one that has not been handed out yet
+    uint32_t slotIndex = NO_SLOT;
+
+    if (! freeSlots.empty())
+    {
+        slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else if (slotsUsed < static_cast<uint32_t>(capacity))
+    {
+        slotIndex = slotsUsed++;
+    }
+    else
+    {
+        ++numDropped;
+        return {};
+    }
+
+    // Stale entries of cancelled triggers are only removed when the heap runs out of room
+    if (heap.size() >= static_cast<size_t>(capacity))
+        compactHeap();
+
+    Slot& slot = slots[slotIndex];
+    ++slot.generation;
+    slot.inUse = true;
+    slot.trigger = trigger;
+    slot.cell = getCellIndex(trigger.cellX, trigger.cellY);
+    slot.previousForCell = NO_SLOT;
+    slot.nextForCell = NO_SLOT;
+
+    const Handle handle { slotIndex, slot.generation };
+
+    // Put the trigger at the front of its cell's list
+    if (slot.cell >= 0)
+    {
+        Handle& head = cellHeads[static_cast<size_t>(slot.cell)];
+
+        if (isPending(head))
+        {
+            slot.nextForCell = head.slot;
+            slots[head.slot].previousForCell = slotIndex;
+        }
+
+        head = handle;
+    }
+
+    // Within the reserved capacity, so this never allocates
+    heap.push_back({ trigger.triggerSample, handle });
+    std::push_heap(heap.begin(), heap.end(), isLater);
+
+    ++numPending;
+    return handle;
+}
+
+bool TriggerScheduler::popDue(int64_t sample, ScheduledTrigger& trigger)
+{
+    while (! heap.empty() && heap.front().triggerSample <= sample)
+    {
+        std::pop_heap(heap.begin(), heap.end(), isLater);
+        const Handle handle = heap.back().handle;
+        heap.pop_back();
+
+        // Skip triggers that were cancelled after they were scheduled
+        if (! isPending(handle))
+            continue;
+
+        trigger = slots[handle.slot].trigger;
+        release(handle.slot);
+        return true;
+    }
+
+    return false;
+}
+
+void TriggerScheduler::cancel(Handle handle)
+{
+    if (isPending(handle))
+        release(handle.slot);
+}
+
+void TriggerScheduler::cancelCell(int cellX, int cellY)
+{
+    const int cell = getCellIndex(cellX, cellY);
+    if (cell < 0)
+        return;
+
+    const Handle head = cellHeads[static_cast<size_t>(cell)];
+    if (! isPending(head))
+        return;
+
+    for (uint32_t slotIndex = head.slot; slotIndex != NO_SLOT;)
+    {
+        const uint32_t next = slots[slotIndex].nextForCell;
+        release(slotIndex);
+        slotIndex = next;
+    }
+}
+
+void TriggerScheduler::clear()
+{
+    // Every slot is handed out again before it is used, which changes its generation, so the
+    // handles of the old triggers (including the cell lists' heads) all go stale at once
+    heap.clear();
+    freeSlots.clear();
+    slotsUsed = 0;
+    numPending = 0;
+}
+
+void TriggerScheduler::release(uint32_t slotIndex)
+{
+    Slot& slot = slots[slotIndex];
+
+    if (slot.previousForCell != NO_SLOT)
+    {
+        slots[slot.previousForCell].nextForCell = slot.nextForCell;
+    }
+    else if (slot.cell >= 0)
+    {
+        // The slot was the head of its cell's list
+        Handle& head = cellHeads[static_cast<size_t>(slot.cell)];
+        head = slot.nextForCell != NO_SLOT ? Handle { slot.nextForCell, slots[slot.nextForCell].generation } : Handle {};
+    }
+
+    if (slot.nextForCell != NO_SLOT)
+        slots[slot.nextForCell].previousForCell = slot.previousForCell;
+
+    slot.inUse = false;
+    freeSlots.push_back(slotIndex);
+    --numPending;
+}
+
+void TriggerScheduler::compactHeap()
+{
+    heap.erase(std::remove_if(heap.begin(), heap.end(),
+                              [this](const HeapEntry& entry) { return ! isPending(entry.handle); }),
+               heap.end());
+    std::make_heap(heap.begin(), heap.end(), isLater);
+}
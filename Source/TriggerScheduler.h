@@ -0,0 +1,118 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <cstdint>
+#include <vector>
+#include "ParameterManager.h"
+
+/**
+ * Pending delayed triggers (timing mode), ordered by the sample they are due at.
+ *
+ * Triggers live in a pool of slots allocated once, up front, and are referred to by generational
+ * handles (slot index plus the slot's generation, which changes every time the slot is reused), so
+ * a stale handle can never reach a newer trigger. A binary min-heap of handles orders the triggers
+ * by time: scheduling and taking the next due trigger are O(log n) and never allocate on the audio
+ * thread. Each cell keeps the list of its pending triggers, so cancelling a cell costs only as
+ * much as the triggers it has; cancelling everything is O(1).
+ *
+ * Overflow policy: when every slot is in use the new trigger is dropped (and counted), so triggers
+ * already promised to the listener are never lost to later ones.
+ */
+class TriggerScheduler
+{
+public:
+    // Room for one pending trigger per cell of the largest grid
+    static const int DEFAULT_CAPACITY = ParameterManager::MAX_GRID_SIZE * ParameterManager::MAX_GRID_SIZE;
+    static const uint32_t NO_SLOT = 0xffffffffu;
+
+    struct ScheduledTrigger
+    {
+        int64_t triggerSample = 0;  // position on the processor's sample clock
+        int sampleIndex = 0;
+        float velocity = 0.0f;
+        int pitchShift = 0;
+        int cellX = -1;             // cell that scheduled the trigger (-1 if none)
+        int cellY = -1;
+        int cellAge = 0;
+    };
+
+    // Refers to one scheduled trigger; stays safe to use after the trigger has fired or been cancelled
+    struct Handle
+    {
+        uint32_t slot = NO_SLOT;
+        uint32_t generation = 0;
+    };
+
+    explicit TriggerScheduler(int capacity = DEFAULT_CAPACITY);
+
+    // Add a trigger. Returns an invalid handle if it was dropped because the scheduler is full.
+    Handle schedule(const ScheduledTrigger& trigger);
+
+    // Take the earliest pending trigger due at or before sample, if there is one
+    bool popDue(int64_t sample, ScheduledTrigger& trigger);
+
+    // Whether a handle still refers to a pending trigger
+    bool isPending(Handle handle) const;
+
+    // Cancel one trigger (nothing happens if it has already fired or been cancelled)
+    void cancel(Handle handle);
+
+    // Cancel every pending trigger of a cell
+    void cancelCell(int cellX, int cellY);
+
+    // Cancel every pending trigger, in constant time
+    void clear();
+
+    int getNumPending() const { return numPending; }
+    int getCapacity() const { return capacity; }
+
+    // Triggers dropped by the overflow policy
+    int getNumDropped() const { return numDropped; }
+
+private:
+    struct Slot
+    {
+        ScheduledTrigger trigger;
+        uint32_t generation = 0;
+        bool inUse = false;
+
+        // Neighbours in the cell's list of pending triggers
+        int cell = -1;
+        uint32_t previousForCell = NO_SLOT;
+        uint32_t nextForCell = NO_SLOT;
+    };
+
+    struct HeapEntry
+    {
+        int64_t triggerSample;
+        Handle handle;
+    };
+
+    // Heap order: the earliest trigger at the front
+    static bool isLater(const HeapEntry& a, const HeapEntry& b) { return a.triggerSample > b.triggerSample; }
+
+    static int getCellIndex(int cellX, int cellY);
+
+    // Take a slot out of the cell lists and return it to the free list
+    void release(uint32_t slot);
+
+    // Remove the heap entries of triggers that have been cancelled
+    void compactHeap();
+
+    const int capacity;
+
+    std::vector<Slot> slots;
+    std::vector<uint32_t> freeSlots;
+    uint32_t slotsUsed = 0;     // slots at or above this have not been handed out since the last clear()
+
+    // Handles in time order; cancelled triggers leave stale entries that are skipped when popped
+    std::vector<HeapEntry> heap;
+
+    // Newest pending trigger of each cell, indexed by y * MAX_GRID_SIZE + x
+    std::vector<Handle> cellHeads;
+
+    int numPending = 0;
+    int numDropped = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TriggerScheduler)
+};
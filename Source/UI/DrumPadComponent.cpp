@@ -151,6 +151,25 @@ void DrumPadComponent::timerCallback()
     updatePadInfo();
 }
 
+void DrumPadComponent::handleJournalEvent(const JournalEvent& event)
+{
+    if (event.pad >= ParameterManager::NUM_SAMPLES)
+        return;
+    
+    auto& pad = pads[event.pad];
+    
+    if (event.type == JournalEvent::Type::Trigger)
+    {
+        pad.lastVelocity = event.value;
+        pad.lastPitch = event.note;
+    }
+    else if (event.type == JournalEvent::Type::PadState)
+    {
+        pad.isPlaying = event.count > 0;
+        pad.level = event.value;
+    }
+}
+
 void DrumPadComponent::updatePadInfo()
 {
     if (drumPads == nullptr)
@@ -158,8 +177,9 @@ void DrumPadComponent::updatePadInfo()
     
     for (int i = 0; i < ParameterManager::NUM_SAMPLES; ++i)
     {
-        bool wasPlaying = pads[i].isPlaying;
-        pads[i].isPlaying = drumPads[i].isPlaying();
+        // Playing state, note and level come from the journal, not from the audio objects
+        bool wasPlaying = pads[i].wasPlaying;
+        pads[i].wasPlaying = pads[i].isPlaying;
         
         // Get the sample filename (without path and extension)
         juce::String sampleName = juce::File(drumPads[i].getFilePath()).getFileNameWithoutExtension();
@@ -174,8 +194,8 @@ void DrumPadComponent::updatePadInfo()
         pads[i].padButton->setButtonText(sampleName);
         
         // Get the most recently played note and velocity
-        juce::String noteStr = drumPads[i].getLastPlayedNoteAsString();
-        int velocityInt = static_cast<int>(drumPads[i].getLastPlayedVelocity() * 127.0f); // Convert to 0-127 scale
+        juce::String noteStr = pads[i].lastPitch > 0 ? juce::MidiMessage::getMidiNoteName(pads[i].lastPitch, true, true, 4) : "-";
+        int velocityInt = static_cast<int>(pads[i].lastVelocity * 127.0f); // Convert to 0-127 scale
         
         // Update the pad information if the playing state has changed
         if (pads[i].isPlaying != wasPlaying || pads[i].isPlaying)
@@ -205,8 +225,7 @@ void DrumPadComponent::updatePadInfo()
         }
         
         // Update the volume history with the current volume level
-        float currentVolume = drumPads[i].getCurrentVolumeLevel();
-        pads[i].addVolumeToHistory(currentVolume);
+        pads[i].addVolumeToHistory(pads[i].isPlaying ? pads[i].level : 0.0f);
     }
     
     repaint();
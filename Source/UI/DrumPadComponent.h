@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include "../DrumPad.h"
+#include "../EventJournal.h"
 #include "../ParameterManager.h"
 
 class DrumPadComponent : public juce::Component,
@@ -24,6 +25,9 @@ public:
     // Set the drum pads
     void setDrumPads(DrumPad* pads) { drumPads = pads; }
     
+    // Take in a Trigger or PadState event from the processor's journal
+    void handleJournalEvent(const JournalEvent& event);
+    
 private:
     ParameterManager& paramManager;
     DrumPad* drumPads = nullptr;
@@ -31,6 +35,8 @@ private:
     struct PadInfo
     {
         bool isPlaying = false;
+        bool wasPlaying = false;    // isPlaying when the pad was last shown
+        float level = 0.0f;         // Output level from the latest PadState event
         float lastVelocity = 0.0f;
         int lastPitch = 0;
         juce::Colour padColor = juce::Colours::darkgrey;
@@ -1,7 +1,8 @@
 #include "GameOfLifeComponent.h"
 
 GameOfLifeComponent::GameOfLifeComponent(ParameterManager& pm)
-    : paramManager(pm)
+    : paramManager(pm),
+      random(static_cast<uint64_t>(juce::Random::getSystemRandom().nextInt64()))
 {
     // Initialize MIDI control label
     midiControlLabel.setText("Game of Life is controlled by MIDI notes: ON = Note On, OFF = Note Off", juce::dontSendNotification);
@@ -40,11 +41,96 @@ GameOfLifeComponent::GameOfLifeComponent(ParameterManager& pm)
     };
     addAndMakeVisible(gridStateTextBox);
     
+    // Initialize grid seed controls
+    gridSeedLabel.setText("Seed:", juce::dontSendNotification);
+    gridSeedLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    addAndMakeVisible(gridSeedLabel);
+    
+    gridSeedSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    gridSeedSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 70, 20);
+    gridSeedSlider.setTooltip("The same seed always gives the same random grids");
+    addAndMakeVisible(gridSeedSlider);
+    
     // Interval controls have been moved to the main tab
     
+    // Initialize grid size controls
+    gridSizeLabel.setText("Grid Size:", juce::dontSendNotification);
+    gridSizeLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    addAndMakeVisible(gridSizeLabel);
+    
+    gridWidthSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    gridWidthSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
+    addAndMakeVisible(gridWidthSlider);
+    
+    gridHeightSlider.setSliderStyle(juce::Slider::IncDecButtons);
+    gridHeightSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 40, 20);
+    addAndMakeVisible(gridHeightSlider);
+    
+    // Initialize column folding controls
+    columnFoldingLabel.setText("Columns:", juce::dontSendNotification);
+    columnFoldingLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    addAndMakeVisible(columnFoldingLabel);
+    
+    columnFoldingComboBox.addItemList(paramManager.getColumnFoldingParam()->choices, 1);
+    columnFoldingComboBox.addListener(this);
+    addAndMakeVisible(columnFoldingComboBox);
+    
+    columnPadMapTextBox.setMultiLine(false);
+    columnPadMapTextBox.setReturnKeyStartsNewLine(false);
+    columnPadMapTextBox.setTextToShowWhenEmpty("Pads, e.g. 1 1 2 2 3 3", juce::Colours::grey);
+    columnPadMapTextBox.setText(paramManager.getColumnPadMap(), false);
+    columnPadMapTextBox.onReturnKey = [this]() {
+        paramManager.setColumnPadMap(columnPadMapTextBox.getText());
+    };
+    columnPadMapTextBox.onFocusLost = [this]() {
+        paramManager.setColumnPadMap(columnPadMapTextBox.getText());
+    };
+    addAndMakeVisible(columnPadMapTextBox);
+    
+    // Initialize life rule controls
+    lifeRuleLabel.setText("Rule:", juce::dontSendNotification);
+    lifeRuleLabel.setFont(juce::Font(juce::Font::getDefaultSansSerifFontName(), 14.0f, juce::Font::bold));
+    addAndMakeVisible(lifeRuleLabel);
+    
+    lifeRuleComboBox.addItemList(paramManager.getLifeRuleParam()->choices, 1);
+    lifeRuleComboBox.addListener(this);
+    addAndMakeVisible(lifeRuleComboBox);
+    
+    customRuleTextBox.setMultiLine(false);
+    customRuleTextBox.setReturnKeyStartsNewLine(false);
+    customRuleTextBox.setTextToShowWhenEmpty("B/S rule, e.g. B36/S23 or B2/S/C3", juce::Colours::grey);
+    customRuleTextBox.setText(paramManager.getCustomRule(), false);
+    customRuleTextBox.onReturnKey = [this]() { applyCustomRule(); };
+    customRuleTextBox.onFocusLost = [this]() { applyCustomRule(); };
+    addAndMakeVisible(customRuleTextBox);
+    
+    // Initialize automatic reseed and cycle status
+    autoReseedComboBox.addItemList(paramManager.getAutoReseedParam()->choices, 1);
+    autoReseedComboBox.setTooltip("Reseed the grid when it settles");
+    addAndMakeVisible(autoReseedComboBox);
+    
+    cycleStatusLabel.setText("Evolving", juce::dontSendNotification);
+    cycleStatusLabel.setJustificationType(juce::Justification::centredRight);
+    addAndMakeVisible(cycleStatusLabel);
+    
     // Create parameter attachments
     randomizeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         paramManager.getAPVTS(), "golRandomize", randomizeButton);
+    gridWidthAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        paramManager.getAPVTS(), "gridWidth", gridWidthSlider);
+    gridHeightAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        paramManager.getAPVTS(), "gridHeight", gridHeightSlider);
+    gridSeedAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        paramManager.getAPVTS(), "gridSeed", gridSeedSlider);
+    columnFoldingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        paramManager.getAPVTS(), "columnFolding", columnFoldingComboBox);
+    lifeRuleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        paramManager.getAPVTS(), "lifeRule", lifeRuleComboBox);
+    autoReseedAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        paramManager.getAPVTS(), "autoReseed", autoReseedComboBox);
+    
+    // The user map is only used by the user map folding
+    columnPadMapTextBox.setEnabled(paramManager.getColumnFolding() == ColumnFolding::UserMap);
     
     // Start the timer for Game of Life updates
     startTimerHz(4); // Update 4 times per second
@@ -55,6 +141,23 @@ GameOfLifeComponent::~GameOfLifeComponent()
     stopTimer();
 }
 
+void GameOfLifeComponent::getGridLayout(int& gridX, int& gridY, int& cellSize) const
+{
+    int gridWidth = snapshot.width;
+    int gridHeight = snapshot.height;
+    
+    // Calculate the grid size
+    auto area = getLocalBounds().reduced(10);
+    int availableHeight = area.getHeight() - 130; // Reserve space for controls
+    cellSize = juce::jmax(1, juce::jmin(area.getWidth() / gridWidth, availableHeight / gridHeight));
+    
+    // Center the grid horizontally
+    gridX = (getWidth() - (cellSize * gridWidth)) / 2;
+    
+    // Position the grid below the controls
+    gridY = 130; // Approximate space used by controls
+}
+
 void GameOfLifeComponent::paint(juce::Graphics& g)
 {
     // Fill the background
@@ -63,42 +166,56 @@ void GameOfLifeComponent::paint(juce::Graphics& g)
     // Draw the Game of Life grid
     if (gameOfLife != nullptr)
     {
-        // Calculate the grid size
-        auto area = getLocalBounds().reduced(10);
-        int gridSize = juce::jmin(area.getWidth(), area.getHeight() - 100); // Reserve space for controls
-        int cellSize = gridSize / ParameterManager::GRID_SIZE;
+        int gridWidth = snapshot.width;
+        int gridHeight = snapshot.height;
         
-        // Center the grid horizontally
-        int gridX = (getWidth() - (cellSize * ParameterManager::GRID_SIZE)) / 2;
+        int gridX, gridY, cellSize;
+        getGridLayout(gridX, gridY, cellSize);
         
-        // Position the grid below the controls
-        int gridY = 100; // Approximate space used by controls
+        // Dead cells share one background fill, so only live (and dying) cells need drawing
+        g.setColour(juce::Colours::black);
+        g.fillRect(gridX, gridY, gridWidth * cellSize, gridHeight * cellSize);
         
-        // Draw the grid
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
+        for (int y = 0; y < gridHeight; ++y)
         {
-            for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+            for (int x = 0; x < gridWidth; ++x)
             {
-                bool cellState = gameOfLife->getCellState(x, y);
-                drawCell(g, x, y, cellState, cellSize);
+                if (snapshot.getCellState(x, y))
+                {
+                    drawCell(g, gridX, gridY, x, y, cellSize);
+                }
+                else if (int dying = snapshot.getDyingState(x, y))
+                {
+                    // Dying cells of a Generations rule fade out as they count down
+                    g.setColour(juce::Colours::grey.withAlpha(juce::jmin(1.0f, 0.15f * dying + 0.2f)));
+                    g.fillRect(gridX + x * cellSize, gridY + y * cellSize, cellSize, cellSize);
+                }
             }
         }
         
-        // Draw grid lines
+        // Draw grid lines (skipped when the cells are too small for them to be useful)
         g.setColour(juce::Colours::grey);
         
-        // Draw horizontal grid lines
-        for (int y = 0; y <= ParameterManager::GRID_SIZE; ++y)
+        if (cellSize >= 6)
         {
-            g.drawLine(gridX, gridY + y * cellSize, 
-                      gridX + ParameterManager::GRID_SIZE * cellSize, gridY + y * cellSize);
+            // Draw horizontal grid lines
+            for (int y = 0; y <= gridHeight; ++y)
+            {
+                g.drawLine(gridX, gridY + y * cellSize, 
+                          gridX + gridWidth * cellSize, gridY + y * cellSize);
+            }
+            
+            // Draw vertical grid lines
+            for (int x = 0; x <= gridWidth; ++x)
+            {
+                g.drawLine(gridX + x * cellSize, gridY, 
+                          gridX + x * cellSize, gridY + gridHeight * cellSize);
+            }
         }
-        
-        // Draw vertical grid lines
-        for (int x = 0; x <= ParameterManager::GRID_SIZE; ++x)
+        else
         {
-            g.drawLine(gridX + x * cellSize, gridY, 
-                      gridX + x * cellSize, gridY + ParameterManager::GRID_SIZE * cellSize);
+            // Just outline the grid
+            g.drawRect(gridX, gridY, gridWidth * cellSize, gridHeight * cellSize, 1);
         }
     }
 }
@@ -108,13 +225,6 @@ void GameOfLifeComponent::resized()
     // Calculate the available area
     auto area = getLocalBounds().reduced(10);
     
-    // Calculate the grid size
-    int gridSize = juce::jmin(area.getWidth(), area.getHeight() - 100); // Reserve space for controls
-    int cellSize = gridSize / ParameterManager::GRID_SIZE;
-    
-    // Center the grid horizontally
-    int gridX = (getWidth() - (cellSize * ParameterManager::GRID_SIZE)) / 2;
-    
     // Position the MIDI control label at the top
     auto labelArea = area.removeFromTop(30);
     midiControlLabel.setBounds(labelArea);
@@ -133,6 +243,30 @@ void GameOfLifeComponent::resized()
     gridStateLabel.setBounds(gridStateLabelArea);
     gridStateTextBox.setBounds(controlsArea.removeFromLeft(200));
     
+    // Grid seed after the grid state
+    gridSeedLabel.setBounds(controlsArea.removeFromLeft(50));
+    gridSeedSlider.setBounds(controlsArea.removeFromLeft(130));
+    
+    // Grid size and column folding controls on the second row
+    auto sizeArea = area.removeFromTop(30);
+    
+    gridSizeLabel.setBounds(sizeArea.removeFromLeft(80));
+    gridWidthSlider.setBounds(sizeArea.removeFromLeft(100));
+    gridHeightSlider.setBounds(sizeArea.removeFromLeft(100));
+    
+    columnFoldingLabel.setBounds(sizeArea.removeFromLeft(70));
+    columnFoldingComboBox.setBounds(sizeArea.removeFromLeft(120));
+    columnPadMapTextBox.setBounds(sizeArea.removeFromLeft(200));
+    
+    // Life rule controls on the third row
+    auto ruleArea = area.removeFromTop(30);
+    
+    lifeRuleLabel.setBounds(ruleArea.removeFromLeft(80));
+    lifeRuleComboBox.setBounds(ruleArea.removeFromLeft(240));
+    customRuleTextBox.setBounds(ruleArea.removeFromLeft(150));
+    autoReseedComboBox.setBounds(ruleArea.removeFromLeft(130));
+    cycleStatusLabel.setBounds(ruleArea);
+    
     // Interval controls have been moved to the main tab
     
     // Reserve space for the grid (rest of the component)
@@ -149,8 +283,8 @@ void GameOfLifeComponent::mouseDown(const juce::MouseEvent& e)
         if (getCellCoordinates(e.getPosition(), x, y))
         {
             // Toggle the cell state
-            bool currentState = gameOfLife->getCellState(x, y);
-            gameOfLife->setCellState(x, y, !currentState);
+            bool currentState = snapshot.getCellState(x, y);
+            gameOfLife->postCommand(GameOfLifeApp::GridCommand::setCell(x, y, !currentState));
             
             // Trigger a repaint
             repaint();
@@ -166,25 +300,16 @@ void GameOfLifeComponent::buttonClicked(juce::Button* button)
     if (button == &randomizeButton)
     {
         // Randomize the grid
-        gameOfLife->initialize(true);
-        
-        // Update the grid state text box
-        gridStateTextBox.setText(getGridStateAsString(), false);
+        gameOfLife->postCommand(GameOfLifeApp::GridCommand::randomize());
         
-        repaint();
+        // The grid and its text box are redrawn once the audio thread publishes the new cells
     }
     else if (button == &clearButton)
     {
         // Clear the grid (initialize without randomizing)
         if (gameOfLife != nullptr)
         {
-            for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-            {
-                for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
-                {
-                    gameOfLife->setCellState(x, y, false);
-                }
-            }
+            gameOfLife->postCommand(GameOfLifeApp::GridCommand::clear());
             
             // Update the grid state text box
             gridStateTextBox.setText("0", false);
@@ -196,10 +321,51 @@ void GameOfLifeComponent::buttonClicked(juce::Button* button)
 
 void GameOfLifeComponent::comboBoxChanged(juce::ComboBox* comboBox)
 {
-    // Handle combo box changes if needed
+    if (comboBox == &columnFoldingComboBox)
+    {
+        // The user map is only used by the user map folding
+        columnPadMapTextBox.setEnabled(columnFoldingComboBox.getSelectedItemIndex() == static_cast<int>(ColumnFolding::UserMap));
+    }
+    
     repaint();
 }
 
+void GameOfLifeComponent::applyCustomRule()
+{
+    // Show the normalised rulestring, or restore the current rule if the text is not valid
+    paramManager.setCustomRule(customRuleTextBox.getText());
+    customRuleTextBox.setText(paramManager.getCustomRule(), false);
+}
+
+void GameOfLifeComponent::updateCycleStatus()
+{
+    juce::String status;
+    
+    switch (gameOfLife->getCycleState())
+    {
+        case CycleState::Extinct:     status = "Extinct"; break;
+        case CycleState::Static:      status = "Static"; break;
+        case CycleState::Oscillating: status = "Period " + juce::String(gameOfLife->getCyclePeriod()); break;
+        case CycleState::Evolving:
+        default:                      status = "Evolving"; break;
+    }
+    
+    cycleStatusLabel.setText(status, juce::dontSendNotification);
+}
+
+void GameOfLifeComponent::updateGrid()
+{
+    if (gameOfLife == nullptr)
+        return;
+    
+    // Show the new generation as soon as its snapshot is available
+    if (gameOfLife->readSnapshot(snapshot))
+    {
+        gridStateTextBox.setText(getGridStateAsString(), false);
+        repaint();
+    }
+}
+
 void GameOfLifeComponent::timerCallback()
 {
     if (gameOfLife == nullptr)
@@ -210,33 +376,27 @@ void GameOfLifeComponent::timerCallback()
     if (processor == nullptr)
         return;
         
-    // Always repaint to update the UI
-    repaint();
+    updateCycleStatus();
     
-    // Update the grid state text box if the grid has changed
-    if (gameOfLife->hasUpdated())
-    {
-        gridStateTextBox.setText(getGridStateAsString(), false);
-    }
+    // Pick up edits and reseeds, which are not journaled as generations
+    updateGrid();
 }
 
 bool GameOfLifeComponent::getCellCoordinates(const juce::Point<int>& position, int& x, int& y)
 {
-    // Calculate the grid size
-    auto area = getLocalBounds().reduced(10);
-    int gridSize = juce::jmin(area.getWidth(), area.getHeight() - 100); // Reserve space for controls
-    int cellSize = gridSize / ParameterManager::GRID_SIZE;
+    if (gameOfLife == nullptr)
+        return false;
     
-    // Center the grid horizontally
-    int gridX = (getWidth() - (cellSize * ParameterManager::GRID_SIZE)) / 2;
+    int gridWidth = snapshot.width;
+    int gridHeight = snapshot.height;
     
-    // Position the grid below the controls
-    int gridY = 100; // Approximate space used by controls
+    int gridX, gridY, cellSize;
+    getGridLayout(gridX, gridY, cellSize);
     
     // Calculate the grid bounds
     juce::Rectangle<int> gridBounds(gridX, gridY, 
-                                    cellSize * ParameterManager::GRID_SIZE, 
-                                    cellSize * ParameterManager::GRID_SIZE);
+                                    cellSize * gridWidth, 
+                                    cellSize * gridHeight);
     
     // Check if the position is within the grid
     if (gridBounds.contains(position))
@@ -246,61 +406,43 @@ bool GameOfLifeComponent::getCellCoordinates(const juce::Point<int>& position, i
         y = (position.y - gridY) / cellSize;
         
         // Ensure the coordinates are within the grid
-        return (x >= 0 && x < ParameterManager::GRID_SIZE && y >= 0 && y < ParameterManager::GRID_SIZE);
+        return (x >= 0 && x < gridWidth && y >= 0 && y < gridHeight);
     }
     
     return false;
 }
 
-void GameOfLifeComponent::drawCell(juce::Graphics& g, int x, int y, bool alive, int cellSize)
+void GameOfLifeComponent::drawCell(juce::Graphics& g, int gridX, int gridY, int x, int y, int cellSize)
 {
-    // Calculate the grid size
-    auto area = getLocalBounds().reduced(10);
-    int gridSize = juce::jmin(area.getWidth(), area.getHeight() - 100); // Reserve space for controls
-    
-    // Center the grid horizontally
-    int gridX = (getWidth() - (cellSize * ParameterManager::GRID_SIZE)) / 2;
-    
-    // Position the grid below the controls
-    int gridY = 100; // Approximate space used by controls
-    
     // Calculate cell position
     int cellX = gridX + x * cellSize;
     int cellY = gridY + y * cellSize;
     
-    // Draw cell background
-    if (alive)
+    // Get the sample index for this column
+    int sampleIndex = paramManager.getSampleForColumn(x);
+    
+    // Choose color based on the sample index
+    juce::Colour cellColor;
+    
+    if (sampleIndex >= 0)
     {
-        // Get the sample index for this column
-        int sampleIndex = paramManager.getSampleForColumn(x);
-        
-        // Choose color based on the sample index
-        juce::Colour cellColor;
-        
-        if (sampleIndex >= 0)
-        {
-            // Use a color based on the sample index
-            float hue = (float)sampleIndex / ParameterManager::NUM_SAMPLES;
-            cellColor = juce::Colour::fromHSV(hue, 0.8f, 0.9f, 1.0f);
-        }
-        else
-        {
-            // Default color for unmapped columns
-            cellColor = juce::Colours::lightgreen;
-        }
-        
-        g.setColour(cellColor);
+        // Use a color based on the sample index
+        float hue = (float)sampleIndex / ParameterManager::NUM_SAMPLES;
+        cellColor = juce::Colour::fromHSV(hue, 0.8f, 0.9f, 1.0f);
     }
     else
     {
-        g.setColour(juce::Colours::black);
+        // Default color for unmapped columns
+        cellColor = juce::Colours::lightgreen;
     }
     
-    g.fillRect(cellX + 1, cellY + 1, cellSize - 2, cellSize - 2);
+    g.setColour(cellColor);
     
-    // Draw cell border
-    g.setColour(juce::Colours::grey);
-    g.drawRect(cellX, cellY, cellSize, cellSize, 1);
+    // Leave a gap for the grid lines on larger cells
+    if (cellSize >= 6)
+        g.fillRect(cellX + 1, cellY + 1, cellSize - 2, cellSize - 2);
+    else
+        g.fillRect(cellX, cellY, cellSize, cellSize);
 }
 
 juce::String GameOfLifeComponent::getGridStateAsString() const
@@ -308,24 +450,35 @@ juce::String GameOfLifeComponent::getGridStateAsString() const
     if (gameOfLife == nullptr)
         return "0";
     
-    // Convert the grid state to a binary string
-    juce::String binaryString;
+    return cellsToString(snapshot.cells.data(), snapshot.wordsPerRow, snapshot.width, snapshot.height);
+}
+
+juce::String GameOfLifeComponent::cellsToString(const GameOfLifeApp::Grid::Word* cells, int wordsPerRow, int width, int height)
+{
+    int numCells = width * height;
+    
+    // Pack the cells into a big integer, with the top-left cell as the most significant bit
+    juce::BigInteger bigInt;
     
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    for (int y = 0; y < height; ++y)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
+        for (int x = 0; x < width; ++x)
         {
-            binaryString += gameOfLife->getCellState(x, y) ? "1" : "0";
+            if ((cells[y * wordsPerRow + x / 64] >> (x % 64)) & 1)
+                bigInt.setBit(numCells - 1 - (y * width + x));
         }
     }
     
-    // Convert binary string to a decimal integer string
-    juce::BigInteger bigInt;
-    bigInt.parseString(binaryString, 2);
-    
+    // Convert to a decimal integer string
     return bigInt.toString(10);
 }
 
+void GameOfLifeComponent::sendCells(const GameOfLifeApp::Grid::Word* cells, int wordsPerRow, int height)
+{
+    for (int y = 0; y < height; ++y)
+        gameOfLife->postCommand(GameOfLifeApp::GridCommand::setRow(y, cells + y * wordsPerRow, wordsPerRow));
+}
+
 void GameOfLifeComponent::setGridStateFromString(const juce::String& stateString)
 {
     if (gameOfLife == nullptr)
@@ -344,48 +497,65 @@ void GameOfLifeComponent::setGridStateFromString(const juce::String& stateString
         gridStateTextBox.setText("0", false);
         
         // Clear the grid
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
-            {
-                gameOfLife->setCellState(x, y, false);
-            }
-        }
+        gameOfLife->postCommand(GameOfLifeApp::GridCommand::clear());
         
         repaint();
         return;
     }
     
-    // Convert to binary string, padded to grid size
-    juce::String binaryString = bigInt.toString(2);
+    // The grid is read with the size the parameters give it (the audio thread applies it)
+    int gridWidth = paramManager.getGridWidth();
+    int gridHeight = paramManager.getGridHeight();
+    int numCells = gridWidth * gridHeight;
+    int wordsPerRow = (gridWidth + 63) / 64;
     
-    // Pad with zeros to match grid size
-    int requiredLength = ParameterManager::GRID_SIZE * ParameterManager::GRID_SIZE;
-    while (binaryString.length() < requiredLength)
-    {
-        binaryString = "0" + binaryString;
-    }
+    // Set the grid state from the bits of the number, the top-left cell being the most
+    // significant (bits beyond the grid size are ignored)
+    std::vector<GameOfLifeApp::Grid::Word> cells(static_cast<size_t>(wordsPerRow * gridHeight), 0);
     
-    // If too long, truncate to grid size
-    if (binaryString.length() > requiredLength)
+    for (int y = 0; y < gridHeight; ++y)
     {
-        binaryString = binaryString.substring(binaryString.length() - requiredLength);
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            if (bigInt[numCells - 1 - (y * gridWidth + x)])
+                cells[static_cast<size_t>(y * wordsPerRow + x / 64)] |= GameOfLifeApp::Grid::Word(1) << (x % 64);
+        }
     }
     
-    // Set the grid state based on the binary string
-    int index = 0;
-    for (int y = 0; y < ParameterManager::GRID_SIZE; ++y)
+    sendCells(cells.data(), wordsPerRow, gridHeight);
+    
+    // The text box shows the normalized value once the audio thread publishes the new cells
+}
+
+juce::String GameOfLifeComponent::randomizeGrid(float density)
+{
+    if (gameOfLife == nullptr)
+        return "0";
+    
+    int gridWidth = paramManager.getGridWidth();
+    int gridHeight = paramManager.getGridHeight();
+    int wordsPerRow = (gridWidth + 63) / 64;
+    
+    // Whole words are drawn, then the bits beyond the last column are cleared
+    const int bitsInLastWord = gridWidth - (wordsPerRow - 1) * 64;
+    const auto lastWordMask = (bitsInLastWord == 64) ? ~GameOfLifeApp::Grid::Word(0)
+                                                     : ((GameOfLifeApp::Grid::Word(1) << bitsInLastWord) - 1);
+    
+    std::vector<GameOfLifeApp::Grid::Word> cells(static_cast<size_t>(wordsPerRow * gridHeight));
+    
+    for (int y = 0; y < gridHeight; ++y)
     {
-        for (int x = 0; x < ParameterManager::GRID_SIZE; ++x)
-        {
-            bool cellState = binaryString[index] == '1';
-            gameOfLife->setCellState(x, y, cellState);
-            index++;
-        }
+        for (int k = 0; k < wordsPerRow; ++k)
+            cells[static_cast<size_t>(y * wordsPerRow + k)] = random.nextBits(density);
+        
+        cells[static_cast<size_t>(y * wordsPerRow + wordsPerRow - 1)] &= lastWordMask;
     }
     
-    // Update the text box with the normalized value
-    gridStateTextBox.setText(getGridStateAsString(), false);
+    sendCells(cells.data(), wordsPerRow, gridHeight);
     
-    repaint();
+    // The string comes from the cells just drawn, not from the snapshot, which the audio
+    // thread has not updated yet
+    juce::String stateString = cellsToString(cells.data(), wordsPerRow, gridWidth, gridHeight);
+    gridStateTextBox.setText(stateString, false);
+    return stateString;
 }
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 #include "../ParameterManager.h"
 #include "../GameOfLife.h"
+#include "../RandomGenerator.h"
 #include "../PluginProcessor.h"
 
 /**
@@ -45,28 +46,80 @@ public:
     // Set grid state from string representation (make it public so it can be accessed from PluginEditor)
     void setGridStateFromString(const juce::String& stateString);
     
+    // Fill the grid with random cells at density, and return the new grid state as a string.
+    // The cells are drawn here rather than by the audio thread, so the string is known at once.
+    juce::String randomizeGrid(float density);
+    
     // Update the grid display
-    void updateGrid() { repaint(); }
+    void updateGrid();
     
 private:
     ParameterManager& paramManager;
     GameOfLife* gameOfLife = nullptr;
     
+    // The grid as last published by the audio thread; everything drawn comes from here
+    GameOfLifeApp::GridSnapshot snapshot;
+    
+    // Random cells for randomizeGrid(), drawn on the message thread
+    GameOfLifeApp::RandomGenerator random;
+    
     juce::Label midiControlLabel;
     juce::TextButton randomizeButton;
     juce::TextButton clearButton;
     juce::TextEditor gridStateTextBox;
     juce::Label gridStateLabel;
     
+    // Seed of the random grids
+    juce::Label gridSeedLabel;
+    juce::Slider gridSeedSlider;
+    
+    // Grid size and column folding controls
+    juce::Label gridSizeLabel;
+    juce::Slider gridWidthSlider;
+    juce::Slider gridHeightSlider;
+    juce::Label columnFoldingLabel;
+    juce::ComboBox columnFoldingComboBox;
+    juce::TextEditor columnPadMapTextBox;
+    
+    // Life rule controls
+    juce::Label lifeRuleLabel;
+    juce::ComboBox lifeRuleComboBox;
+    juce::TextEditor customRuleTextBox;
+    
+    // Automatic reseed and cycle status
+    juce::ComboBox autoReseedComboBox;
+    juce::Label cycleStatusLabel;
+    
     // Interval controls - Removed as they've been moved to the main tab
     
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> randomizeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gridWidthAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gridHeightAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> gridSeedAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> columnFoldingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> lifeRuleAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> autoReseedAttachment;
+    
+    // Show what the automaton is doing (evolving, extinct, static, or oscillating)
+    void updateCycleStatus();
+    
+    // Apply the rulestring typed in the custom rule text box
+    void applyCustomRule();
+    
+    // Calculate the position of the grid and the size of each cell for the current grid dimensions
+    void getGridLayout(int& gridX, int& gridY, int& cellSize) const;
     
     // Convert mouse position to grid coordinates
     bool getCellCoordinates(const juce::Point<int>& position, int& x, int& y);
     
-    // Draw a single cell
-    void drawCell(juce::Graphics& g, int x, int y, bool alive, int cellSize);
+    // Send cells (wordsPerRow words per row, like Grid::storeCells()) to the grid, a row at a time
+    void sendCells(const GameOfLifeApp::Grid::Word* cells, int wordsPerRow, int height);
+    
+    // Grid state string of cells laid out like Grid::storeCells()
+    static juce::String cellsToString(const GameOfLifeApp::Grid::Word* cells, int wordsPerRow, int width, int height);
+    
+    // Draw a single live cell
+    void drawCell(juce::Graphics& g, int gridX, int gridY, int x, int y, int cellSize);
     
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(GameOfLifeComponent)
 };
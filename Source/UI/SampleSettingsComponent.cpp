@@ -108,6 +108,28 @@ SampleSettingsComponent::SampleSettingsComponent(ParameterManager& pm, int start
         controls->outputSelector.setSelectedItemIndex(0); // Default to main output
         addAndMakeVisible(controls->outputSelector);
         
+        // Set up age modulation selector
+        controls->ageModulationSelector.addItem("Age: Off", 1);
+        controls->ageModulationSelector.addItem("Age: Velocity", 2);
+        controls->ageModulationSelector.addItem("Age: Envelope", 3);
+        controls->ageModulationSelector.addItem("Age: Pitch", 4);
+        controls->ageModulationSelector.setSelectedItemIndex(0); // Default to off
+        addAndMakeVisible(controls->ageModulationSelector);
+        
+        // Set up output mode selector and MIDI channel slider
+        controls->padOutputModeSelector.addItem("Sampler", 1);
+        controls->padOutputModeSelector.addItem("MIDI", 2);
+        controls->padOutputModeSelector.addItem("Sampler + MIDI", 3);
+        controls->padOutputModeSelector.setSelectedItemIndex(0); // Default to the sampler only
+        addAndMakeVisible(controls->padOutputModeSelector);
+        
+        controls->midiChannelSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+        controls->midiChannelSlider.setTextBoxStyle(juce::Slider::TextBoxRight, false, 60, 20);
+        controls->midiChannelSlider.setRange(1, 16, 1);
+        controls->midiChannelSlider.setTextValueSuffix(" Ch");
+        controls->midiChannelSlider.setValue(10, juce::dontSendNotification); // Default to the GM drum channel
+        addAndMakeVisible(controls->midiChannelSlider);
+        
         // Set up ADSR component
         controls->adsrComponent.addListener(this);
         // Set default ADSR values
@@ -149,6 +171,15 @@ SampleSettingsComponent::SampleSettingsComponent(ParameterManager& pm, int start
             
         controls->outputAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
             apvts, "output_" + juce::String(sampleIndex), controls->outputSelector);
+            
+        controls->ageModulationAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            apvts, "age_mod_" + juce::String(sampleIndex), controls->ageModulationSelector);
+            
+        controls->padOutputModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+            apvts, "pad_output_mode_" + juce::String(sampleIndex), controls->padOutputModeSelector);
+            
+        controls->midiChannelAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+            apvts, "midi_channel_" + juce::String(sampleIndex), controls->midiChannelSlider);
         
         // Connect ADSR controls to parameters
         controls->adsrComponent.connectToParameters(apvts, sampleIndex);
@@ -248,6 +279,18 @@ void SampleSettingsComponent::resized()
         controls->outputSelector.setBounds(x + margin, controlY, sampleWidth - 2 * margin, controlHeight);
         controlY += controlHeight + controlSpacing;
         
+        // Age modulation selector
+        controls->ageModulationSelector.setBounds(x + margin, controlY, sampleWidth - 2 * margin, controlHeight);
+        controlY += controlHeight + controlSpacing;
+        
+        // Output mode selector
+        controls->padOutputModeSelector.setBounds(x + margin, controlY, sampleWidth - 2 * margin, controlHeight);
+        controlY += controlHeight + controlSpacing;
+        
+        // MIDI channel slider
+        controls->midiChannelSlider.setBounds(x + margin, controlY, sampleWidth - 2 * margin, controlHeight);
+        controlY += controlHeight + controlSpacing;
+        
         // ADSR component - give it more height
         int adsrHeight = 280; // Increased from 250 to ensure all controls are visible
         controls->adsrComponent.setBounds(x + margin, controlY, sampleWidth - 2 * margin, adsrHeight);
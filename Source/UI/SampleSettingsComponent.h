@@ -64,6 +64,9 @@ private:
         juce::Label filenameLabel;
         juce::ToggleButton legatoButton;
         juce::ComboBox outputSelector;         // New dropdown for output selection
+        juce::ComboBox ageModulationSelector;  // What the triggering cell's age modulates
+        juce::ComboBox padOutputModeSelector;  // Sampler, MIDI output, or both
+        juce::Slider midiChannelSlider;        // MIDI output channel
         ADSRComponent adsrComponent;
         
         // Parameter attachments
@@ -78,6 +81,9 @@ private:
         std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> timingModeAttachment;
         std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> legatoAttachment;
         std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> outputAttachment;     // New attachment for output selection
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> ageModulationAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> padOutputModeAttachment;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> midiChannelAttachment;
         
         // Delete copy constructor and assignment operator
         SampleControls() = default;
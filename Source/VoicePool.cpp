@@ -0,0 +1,419 @@
+#include "VoicePool.h"
+#include <algorithm>
+#include <cmath>
+
+VoicePool::VoicePool()
+{
+    envelopeScales.fill(1.0f);
+    clear();
+}
+
+void VoicePool::clear()
+{
+    for (int pad = 0; pad < NUM_PADS; ++pad)
+        clearPad(pad);
+}
+
+void VoicePool::clearPad(int pad)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+
+    // Stack the pad's voices on its free list, the lowest index on top
+    for (int i = 0; i < VOICES_PER_PAD; ++i)
+    {
+        const int voice = (pad + 1) * VOICES_PER_PAD - 1 - i;
+        freeVoices[padIndex][static_cast<size_t>(i)] = static_cast<uint16_t>(voice);
+        envelopeStates[static_cast<size_t>(voice)] = EnvelopeState::Idle;
+    }
+
+    numFree[padIndex] = VOICES_PER_PAD;
+    numActive[padIndex] = 0;
+}
+
+int VoicePool::startVoice(int pad, int sampleOffset)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+
+    if (numFree[padIndex] == 0)
+        return -1;
+
+    const int voice = freeVoices[padIndex][static_cast<size_t>(--numFree[padIndex])];
+    activeVoices[padIndex][static_cast<size_t>(numActive[padIndex]++)] = static_cast<uint16_t>(voice);
+
+    const size_t v = static_cast<size_t>(voice);
+    positions[v] = 0.0;
+    rates[v] = 1.0f;
+    gains[v] = 1.0f;
+    startOffsets[v] = sampleOffset;
+    releaseOffsets[v] = -1;
+    cellXs[v] = -1;
+    cellYs[v] = -1;
+    envelopeStates[v] = EnvelopeState::Attack;
+    envelopeLevels[v] = 0.0f;
+    releasing[v] = false;
+    envelopeScales[v] = 1.0f;
+
+    return voice;
+}
+
+void VoicePool::removeOldestVoices(int pad, int count)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+    auto& voices = activeVoices[padIndex];
+    const int numActiveVoices = numActive[padIndex];
+    count = juce::jlimit(0, numActiveVoices, count);
+
+    for (int i = 0; i < count; ++i)
+        freeVoices[padIndex][static_cast<size_t>(numFree[padIndex]++)] = voices[static_cast<size_t>(i)];
+
+    std::copy(voices.begin() + count, voices.begin() + numActiveVoices, voices.begin());
+    numActive[padIndex] = numActiveVoices - count;
+}
+
+void VoicePool::removeFinishedVoices(int pad)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+    auto& voices = activeVoices[padIndex];
+    int kept = 0;
+
+    for (int i = 0; i < numActive[padIndex]; ++i)
+    {
+        const uint16_t voice = voices[static_cast<size_t>(i)];
+
+        if (envelopeStates[voice] == EnvelopeState::Idle)
+            freeVoices[padIndex][static_cast<size_t>(numFree[padIndex]++)] = voice;
+        else
+            voices[static_cast<size_t>(kept++)] = voice;
+    }
+
+    numActive[padIndex] = kept;
+}
+
+void VoicePool::setEnvelopeRates(int voice, float attack, float decay, float sustain, float release)
+{
+    const size_t v = static_cast<size_t>(voice);
+    attackRates[v] = attack / envelopeScales[v];
+    decayRates[v] = decay / envelopeScales[v];
+    sustainLevels[v] = sustain;
+    releaseRates[v] = release / envelopeScales[v];
+}
+
+void VoicePool::setEnvelopeTimes(int voice, float attackTimeMs, float decayTimeMs, float sustainLevel, float releaseTimeMs,
+                                 double sampleRate)
+{
+    // Convert times in milliseconds to rates per sample (a zero time moves in a single sample)
+    const float samplesPerMs = static_cast<float>(sampleRate) * 0.001f;
+
+    const float attackRate = attackTimeMs > 0.0f ? 1.0f / (attackTimeMs * samplesPerMs) : 1.0f;
+    const float decayRate = decayTimeMs > 0.0f ? (1.0f - sustainLevel) / (decayTimeMs * samplesPerMs) : 1.0f;
+    const float releaseRate = releaseTimeMs > 0.0f ? sustainLevel / (releaseTimeMs * samplesPerMs) : 1.0f;
+
+    setEnvelopeRates(voice, attackRate, decayRate, sustainLevel, releaseRate);
+}
+
+void VoicePool::noteOff(int voice)
+{
+    const size_t v = static_cast<size_t>(voice);
+
+    if (envelopeStates[v] != EnvelopeState::Release && envelopeStates[v] != EnvelopeState::Idle)
+    {
+        envelopeStates[v] = EnvelopeState::Release;
+        releasing[v] = true;
+    }
+}
+
+void VoicePool::renderPad(int pad, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                          int startSample, int numSamples, float padVolume, float pan,
+                          MixKernel::Interpolation interpolation)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+    const int numVoices = numActive[padIndex];
+
+    if (numVoices == 0 || sample.getNumSamples() == 0)
+        return;
+
+    const auto& voices = activeVoices[padIndex];
+
+    // Channel gains of every voice for the block, in one pass over the pad's voices
+    const float leftScale = padVolume * (pan <= 0.0f ? 1.0f : 1.0f - pan);
+    const float rightScale = padVolume * (pan >= 0.0f ? 1.0f : 1.0f + pan);
+
+    std::array<float, VOICES_PER_PAD> leftGains;
+    std::array<float, VOICES_PER_PAD> rightGains;
+
+    for (int i = 0; i < numVoices; ++i)
+    {
+        const float gain = gains[voices[static_cast<size_t>(i)]];
+        leftGains[static_cast<size_t>(i)] = gain * leftScale;
+        rightGains[static_cast<size_t>(i)] = gain * rightScale;
+    }
+
+    for (int i = 0; i < numVoices; ++i)
+    {
+        renderVoice(voices[static_cast<size_t>(i)], sample, buffer, startSample, numSamples,
+                    leftGains[static_cast<size_t>(i)], rightGains[static_cast<size_t>(i)], interpolation);
+    }
+
+    removeFinishedVoices(pad);
+}
+
+void VoicePool::skipPad(int pad, int numSamples)
+{
+    const size_t padIndex = static_cast<size_t>(pad);
+
+    for (int i = 0; i < numActive[padIndex]; ++i)
+    {
+        const size_t v = activeVoices[padIndex][static_cast<size_t>(i)];
+        const int offset = startOffsets[v];
+        const int releaseOffset = releaseOffsets[v];
+
+        // The same offset bookkeeping as renderVoice(), without the mixing
+        if (offset >= numSamples)
+        {
+            startOffsets[v] = offset - numSamples;
+
+            if (releaseOffset >= 0)
+                releaseOffsets[v] = juce::jmax(0, releaseOffset - numSamples);
+        }
+        else
+        {
+            startOffsets[v] = 0;
+
+            if (releaseOffset >= numSamples)
+                releaseOffsets[v] = releaseOffset - numSamples;
+            else if (releaseOffset >= 0)
+                releaseAtOffset(static_cast<int>(v));
+        }
+    }
+}
+
+void VoicePool::releaseAtOffset(int voice)
+{
+    const size_t v = static_cast<size_t>(voice);
+    releaseOffsets[v] = -1;
+
+    if (envelopeStates[v] != EnvelopeState::Idle && ! releasing[v])
+    {
+        envelopeStates[v] = EnvelopeState::Release;
+        releasing[v] = true;
+    }
+}
+
+void VoicePool::renderVoice(int voice, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                            int startSample, int numSamples, float leftGain, float rightGain,
+                            MixKernel::Interpolation interpolation)
+{
+    const size_t v = static_cast<size_t>(voice);
+
+    // A voice triggered partway through the block starts at its offset; the part before it is silent
+    const int offset = startOffsets[v];
+    const int releaseOffset = releaseOffsets[v];
+
+    if (offset >= numSamples)
+    {
+        startOffsets[v] = offset - numSamples;
+
+        if (releaseOffset >= 0)
+            releaseOffsets[v] = juce::jmax(0, releaseOffset - numSamples);
+
+        return;
+    }
+
+    startOffsets[v] = 0;
+
+    // A release partway through the block splits the voice's rendering at the release
+    if (releaseOffset >= numSamples)
+    {
+        releaseOffsets[v] = releaseOffset - numSamples;
+    }
+    else if (releaseOffset >= 0)
+    {
+        const int releaseStart = juce::jmax(offset, releaseOffset);
+
+        if (releaseStart > offset)
+            mixVoice(voice, sample, buffer, startSample + offset, releaseStart - offset, leftGain, rightGain, interpolation);
+
+        releaseAtOffset(voice);
+
+        mixVoice(voice, sample, buffer, startSample + releaseStart, numSamples - releaseStart, leftGain, rightGain, interpolation);
+        return;
+    }
+
+    mixVoice(voice, sample, buffer, startSample + offset, numSamples - offset, leftGain, rightGain, interpolation);
+}
+
+void VoicePool::mixVoice(int voice, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                         int startSample, int numSamples, float leftGain, float rightGain,
+                         MixKernel::Interpolation interpolation)
+{
+    const size_t v = static_cast<size_t>(voice);
+
+    if (envelopeStates[v] == EnvelopeState::Idle)
+        return;
+
+    const int numSourceChannels = sample.getNumChannels();
+    const int numOutputChannels = buffer.getNumChannels();
+    const double position = positions[v];
+    const float rate = rates[v];
+
+    // The block is rendered in chunks, each with its envelope generated first
+    std::array<float, ENVELOPE_CHUNK_SIZE> envelope;
+
+    for (int chunkStart = 0; chunkStart < numSamples && envelopeStates[v] != EnvelopeState::Idle; chunkStart += ENVELOPE_CHUNK_SIZE)
+    {
+        const int chunkSize = juce::jmin(ENVELOPE_CHUNK_SIZE, numSamples - chunkStart);
+        const double chunkPosition = position + chunkStart * static_cast<double>(rate);
+
+        renderEnvelope(voice, envelope.data(), chunkSize);
+
+        // Mix the sample into the first two output channels in one pass (a mono sample feeds both)
+        if (numOutputChannels > 0)
+        {
+            MixKernel::Source source;
+            source.left = sample.getReadPointer(0);
+            source.right = sample.getReadPointer(numSourceChannels > 1 ? 1 : 0);
+            source.length = sample.getNumSamples();
+
+            MixKernel::Output output;
+            output.left = buffer.getWritePointer(0, startSample + chunkStart);
+            output.right = numOutputChannels > 1 ? buffer.getWritePointer(1, startSample + chunkStart) : nullptr;
+            output.numSamples = chunkSize;
+            output.envelope = envelope.data();
+
+            MixKernel::mix(source, chunkPosition, rate, leftGain, rightGain, output, interpolation);
+        }
+
+        // Any further channels get their own sample channel (or the first) with the right gain
+        for (int channel = 2; channel < numOutputChannels; ++channel)
+        {
+            MixKernel::Source source;
+            source.left = sample.getReadPointer(channel < numSourceChannels ? channel : 0);
+            source.right = source.left;
+            source.length = sample.getNumSamples();
+
+            MixKernel::Output output;
+            output.left = buffer.getWritePointer(channel, startSample + chunkStart);
+            output.numSamples = chunkSize;
+            output.envelope = envelope.data();
+
+            MixKernel::mix(source, chunkPosition, rate, rightGain, rightGain, output, interpolation);
+        }
+    }
+
+    positions[v] = position + numSamples * static_cast<double>(rate);
+
+    // A one-shot sample that has run out moves on to its release
+    if (positions[v] >= sample.getNumSamples() && ! releasing[v])
+        noteOff(voice);
+}
+
+int VoicePool::getSegmentLength(float distance, float rate)
+{
+    // Steps of rate until the level has moved by distance (at least one, so the segment ends)
+    if (distance <= 0.0f)
+        return 0;
+
+    return juce::jmax(1, static_cast<int>(std::ceil(distance / rate)));
+}
+
+void VoicePool::renderEnvelope(int voice, float* levels, int numSamples)
+{
+    const size_t v = static_cast<size_t>(voice);
+    const float attackRate = attackRates[v];
+    const float decayRate = decayRates[v];
+    const float sustainLevel = sustainLevels[v];
+    const float releaseRate = releaseRates[v];
+
+    EnvelopeState state = envelopeStates[v];
+    float level = envelopeLevels[v];
+
+    // Each pass fills one segment, or the part of it inside the block: the number of samples to
+    // the segment's end is worked out up front, so the ramps themselves have no branches
+    int done = 0;
+
+    while (done < numSamples)
+    {
+        const int remaining = numSamples - done;
+
+        switch (state)
+        {
+            case EnvelopeState::Attack:
+            {
+                const int length = attackRate > 0.0f ? getSegmentLength(1.0f - level, attackRate) : 0;
+                const int count = juce::jmin(length, remaining);
+
+                MixKernel::fillRamp(levels + done, count, level, attackRate);
+                level += attackRate * count;
+                done += count;
+
+                // Reached full level: land on it exactly and move on to the decay
+                if (count == length)
+                {
+                    level = 1.0f;
+                    state = EnvelopeState::Decay;
+
+                    if (count > 0)
+                        levels[done - 1] = level;
+                }
+                break;
+            }
+
+            case EnvelopeState::Decay:
+            {
+                const int length = decayRate > 0.0f ? getSegmentLength(level - sustainLevel, decayRate) : 0;
+                const int count = juce::jmin(length, remaining);
+
+                MixKernel::fillRamp(levels + done, count, level, -decayRate);
+                level -= decayRate * count;
+                done += count;
+
+                if (count == length)
+                {
+                    level = sustainLevel;
+                    state = EnvelopeState::Sustain;
+
+                    if (count > 0)
+                        levels[done - 1] = level;
+                }
+                break;
+            }
+
+            case EnvelopeState::Sustain:
+                // Hold the sustain level for the rest of the block
+                level = sustainLevel;
+                std::fill(levels + done, levels + numSamples, level);
+                done = numSamples;
+                break;
+
+            case EnvelopeState::Release:
+            {
+                const int length = releaseRate > 0.0f ? getSegmentLength(level, releaseRate) : 0;
+                const int count = juce::jmin(length, remaining);
+
+                MixKernel::fillRamp(levels + done, count, level, -releaseRate);
+                level -= releaseRate * count;
+                done += count;
+
+                if (count == length)
+                {
+                    level = 0.0f;
+                    state = EnvelopeState::Idle;
+
+                    if (count > 0)
+                        levels[done - 1] = level;
+                }
+                break;
+            }
+
+            case EnvelopeState::Idle:
+            default:
+                // Silent from here on
+                std::fill(levels + done, levels + numSamples, 0.0f);
+                done = numSamples;
+                break;
+        }
+    }
+
+    envelopeStates[v] = state;
+    envelopeLevels[v] = level;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <cstdint>
+#include "MixKernel.h"
+#include "ParameterManager.h"
+
+/**
+ * Every sample-playback voice of the processor, allocated once, laid out as structure-of-arrays.
+ *
+ * A voice is an index into the state arrays below. Each pad owns a fixed range of
+ * VOICES_PER_PAD voices, with a free list and a list of its playing voices (oldest first, the
+ * order voice stealing takes them in), so starting and stealing voices never allocate and never
+ * move voice state. A pad's sample buffer is passed in when the pad is rendered rather than
+ * stored with each voice.
+ */
+class VoicePool
+{
+public:
+    static const int NUM_PADS = ParameterManager::NUM_SAMPLES;
+    static const int VOICES_PER_PAD = 16;
+    static const int CAPACITY = NUM_PADS * VOICES_PER_PAD;
+
+    // ADSR envelope stage of a voice
+    enum class EnvelopeState : uint8_t
+    {
+        Idle,
+        Attack,
+        Decay,
+        Sustain,
+        Release
+    };
+
+    VoicePool();
+
+    // Take a free voice of the pad and make it the pad's newest, playing from the start of the
+    // sample sampleOffset samples into the next rendered block. Returns the voice, or -1 if the
+    // pad has none free.
+    int startVoice(int pad, int sampleOffset = 0);
+
+    // Return the pad's count oldest voices to its free list
+    void removeOldestVoices(int pad, int count);
+
+    // Return every voice of a pad, or of every pad, to the free lists
+    void clearPad(int pad);
+    void clear();
+
+    // The pad's playing voices, oldest first
+    int getNumVoices(int pad) const { return numActive[static_cast<size_t>(pad)]; }
+    int getVoice(int pad, int index) const { return activeVoices[static_cast<size_t>(pad)][static_cast<size_t>(index)]; }
+
+    // Whether a voice was started by the given cell
+    bool isForCell(int voice, int x, int y) const { return cellXs[static_cast<size_t>(voice)] == x && cellYs[static_cast<size_t>(voice)] == y; }
+
+    // Set a voice's envelope rates (per sample, before its envelope scale) and sustain level
+    void setEnvelopeRates(int voice, float attack, float decay, float sustain, float release);
+
+    // Set a voice's envelope from times in milliseconds
+    void setEnvelopeTimes(int voice, float attackTimeMs, float decayTimeMs, float sustainLevel, float releaseTimeMs,
+                          double sampleRate);
+
+    // Start a voice's release (nothing happens if it is already releasing or idle)
+    void noteOff(int voice);
+
+    // Mix every voice of the pad from its sample into buffer with the pad's volume and pan,
+    // then return the voices that have finished to the pad's free list
+    void renderPad(int pad, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                   int startSample, int numSamples, float padVolume, float pan,
+                   MixKernel::Interpolation interpolation);
+
+    // Move the pad's pending start and release offsets on past a block it is not rendered in
+    // (muted, or routed nowhere), so they do not land in a later block
+    void skipPad(int pad, int numSamples);
+
+    // Voice state, indexed by voice
+    std::array<double, CAPACITY> positions {};          // playback position in the sample (fractional)
+    std::array<float, CAPACITY> rates {};               // playback rate (pitch)
+    std::array<float, CAPACITY> gains {};               // velocity
+    std::array<int, CAPACITY> startOffsets {};          // samples into the next block at which the voice starts
+    std::array<int, CAPACITY> releaseOffsets {};        // samples into the next block at which it is released (-1 if none)
+    std::array<int16_t, CAPACITY> cellXs {};            // cell that started the voice (-1 if none)
+    std::array<int16_t, CAPACITY> cellYs {};
+
+    // Envelope state, indexed by voice
+    std::array<EnvelopeState, CAPACITY> envelopeStates {};
+    std::array<float, CAPACITY> envelopeLevels {};
+    std::array<bool, CAPACITY> releasing {};
+    std::array<float, CAPACITY> attackRates {};
+    std::array<float, CAPACITY> decayRates {};
+    std::array<float, CAPACITY> sustainLevels {};
+    std::array<float, CAPACITY> releaseRates {};
+    std::array<float, CAPACITY> envelopeScales {};      // attack, decay and release times are stretched by this
+
+private:
+    // Samples rendered per envelope chunk in mixVoice()
+    static const int ENVELOPE_CHUNK_SIZE = 256;
+
+    // Samples for a segment moving by rate per sample to cover distance
+    static int getSegmentLength(float distance, float rate);
+
+    // Release a voice that has reached its deferred release offset
+    void releaseAtOffset(int voice);
+
+    // Render a voice, starting at its start offset and splitting at its release offset
+    void renderVoice(int voice, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                     int startSample, int numSamples, float leftGain, float rightGain,
+                     MixKernel::Interpolation interpolation);
+
+    // Mix numSamples of a voice into buffer from startSample
+    void mixVoice(int voice, const juce::AudioBuffer<float>& sample, juce::AudioBuffer<float>& buffer,
+                  int startSample, int numSamples, float leftGain, float rightGain,
+                  MixKernel::Interpolation interpolation);
+
+    // Advance a voice's envelope sample by sample, writing its level after each sample to levels
+    void renderEnvelope(int voice, float* levels, int numSamples);
+
+    // Return the pad's idle voices to its free list, keeping the others in order
+    void removeFinishedVoices(int pad);
+
+    // Each pad's playing voices (oldest first) and free voices
+    std::array<std::array<uint16_t, VOICES_PER_PAD>, NUM_PADS> activeVoices {};
+    std::array<std::array<uint16_t, VOICES_PER_PAD>, NUM_PADS> freeVoices {};
+    std::array<int, NUM_PADS> numActive {};
+    std::array<int, NUM_PADS> numFree {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(VoicePool)
+};